@@ -11,10 +11,16 @@
 #include <sys/stat.h>
 #include <semaphore.h>
 #include <signal.h>
-#include <termios.h>
-#include <sys/select.h>
 #include <errno.h>
 
+#include "term.h"
+#include "evloop.h"
+#include "snake.h"
+#include "mines.h"
+#include "minesolver.h"
+#include "synth.h"
+#include "history.h"
+
 // Define constants for maximum tasks, name length, path length, and time quantum for Round Robin scheduling
 #define MAX_TASKS 50
 #define MAX_NAME_LENGTH 50
@@ -68,6 +74,7 @@ int current_mode = 0;             // Current mode (0 for User, 1 for Kernel)
 sem_t resource_sem;               // Semaphore for resource management
 pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;  // Mutex for task queue
 SchedulingAlgorithm current_scheduler = FCFS;  // Current scheduling algorithm
+History history;                  // Sampled load history shown by the system monitor
 
 // Function prototypes
 void boot_os();
@@ -83,6 +90,7 @@ void shutdown_os();
 void manage_resources(int ram, int hdd, int cpu, int allocate);
 int check_resources(int ram, int hdd, int cpu);
 void schedule_tasks();
+void sample_system(HistorySample* sample, void* arg);
 void set_scheduling_algorithm();
 void show_scheduling_info();
 
@@ -101,6 +109,7 @@ void system_monitor();
 void process_manager();
 void memory_viewer();
 void help_system();
+void mine_benchmark();
 void snake_game();
 void end_task_immediately();
 
@@ -112,9 +121,15 @@ void print_warning(char* message);
 void print_info(char* message);
 void loading_animation(char* message, int seconds);
 void beep_sound(int duration_ms, int frequency);
-int kbhit();
+int run_command_line(int argc, char* argv[]);
+int screen_loop_init(EventLoop* loop, EventKeyCallback on_key, EventTimerCallback on_tick, long interval_ms, void* arg);
+
+int main(int argc, char* argv[]) {
+    // Command-line modes run without the interactive menu
+    if (argc > 1) {
+        return run_command_line(argc, argv);
+    }
 
-int main() {
     // Initialize semaphore
     if (sem_init(&resource_sem, 0, 1) != 0) {
         perror("Failed to initialize semaphore");
@@ -146,6 +161,10 @@ int main() {
 
     boot_os();
 
+    if (history_start(&history, HISTORY_INTERVAL_MS, sample_system, NULL) != 0) {
+        print_warning("Load history is unavailable!");
+    }
+
     // Ask for the mode
     printf("\nSelect Mode:\n");
     printf("1. User Mode\n");
@@ -253,6 +272,7 @@ int main() {
         case 15: end_task_immediately(); break;
         case 16: switch_mode(); break;
         case 17: shutdown_os(); break;
+        case 18: execute_task("Mine Benchmark"); break;
         default: print_error("Invalid choice!"); sleep(1); break;
         }
 
@@ -293,7 +313,7 @@ void show_main_menu() {
         printf("%s|  6. Move File          | 15. End Task Now       |%s\n", COLOR_YELLOW, COLOR_RESET);
         printf("%s|  7. Copy File          | 16. Switch Mode        |%s\n", COLOR_YELLOW, COLOR_RESET);
         printf("%s|  8. Delete File        | 17. Shutdown           |%s\n", COLOR_YELLOW, COLOR_RESET);
-        printf("%s|  9. Set CPU Scheduling |                        |%s\n", COLOR_YELLOW, COLOR_RESET);
+        printf("%s|  9. Set CPU Scheduling | 18. Mine Benchmark     |%s\n", COLOR_YELLOW, COLOR_RESET);
     }
     else {
         printf("%s| 1. Memory Viewer%s\n", COLOR_YELLOW, COLOR_RESET);
@@ -364,6 +384,9 @@ void execute_task(char* task_name) {
     else if (strcmp(task_name, "Help System") == 0) {
         ram = 30; hdd = 5; cpu = 1;
     }
+    else if (strcmp(task_name, "Mine Benchmark") == 0) {
+        ram = 80; hdd = 1; cpu = 2;
+    }
 
     create_process(task_name, ram, hdd, cpu);
 }
@@ -403,6 +426,7 @@ void create_process(char* task_name, int ram, int hdd, int cpu) {
 
             manage_resources(ram, hdd, cpu, 1);
             task_count++;
+            history_count_start(&history);
 
             print_success("Task started in background in a new terminal!");
         }
@@ -463,6 +487,9 @@ void create_process(char* task_name, int ram, int hdd, int cpu) {
         else if (strcmp(task_name, "Help System") == 0) {
             help_system();
         }
+        else if (strcmp(task_name, "Mine Benchmark") == 0) {
+            mine_benchmark();
+        }
     }
 }
 
@@ -736,6 +763,7 @@ void close_task(int task_index) {
     task_count--;
 
     pthread_mutex_unlock(&queue_mutex);
+    history_count_exit(&history);
 
     print_success("Task closed successfully!");
     sleep(1);
@@ -781,6 +809,7 @@ void shutdown_os() {
         }
     }
 
+    history_stop(&history);
     loading_animation("Shutting down", 3);
     exit(0);
 }
@@ -911,57 +940,71 @@ void show_time() {
     getchar(); getchar();
 }
 
-void calendar() {
-    while (1) {
-        time_t now = time(NULL);
-        struct tm* tm_info = localtime(&now);
+void draw_calendar() {
+    time_t now = time(NULL);
+    struct tm* tm_info = localtime(&now);
 
-        clear_screen();
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s              CALENDAR%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    // Draw the whole month into the back buffer; only changed cells reach the terminal
+    term_clear();
+    term_print(0, 0, TERM_AQUA, "======================================");
+    term_print(0, 1, TERM_AQUA, "              CALENDAR");
+    term_print(0, 2, TERM_AQUA, "======================================");
 
-        printf("     %02d/%04d\n", tm_info->tm_mon + 1, tm_info->tm_year + 1900);
-        printf("Su Mo Tu We Th Fr Sa\n");
+    term_print(5, 3, TERM_DEFAULT, "%02d/%04d", tm_info->tm_mon + 1, tm_info->tm_year + 1900);
+    term_print(0, 4, TERM_DEFAULT, "Su Mo Tu We Th Fr Sa");
 
-        struct tm first_day = *tm_info;
-        first_day.tm_mday = 1;
-        mktime(&first_day);
+    struct tm first_day = *tm_info;
+    first_day.tm_mday = 1;
+    mktime(&first_day);
 
-        int day_of_week = first_day.tm_wday;
-        int days_in_month;
+    int day_of_week = first_day.tm_wday;
+    int days_in_month;
 
-        switch (tm_info->tm_mon + 1) {
-        case 4: case 6: case 9: case 11: days_in_month = 30; break;
-        case 2:
-            days_in_month = ((tm_info->tm_year + 1900) % 4 == 0) ? 29 : 28;
-            break;
-        default: days_in_month = 31;
-        }
+    switch (tm_info->tm_mon + 1) {
+    case 4: case 6: case 9: case 11: days_in_month = 30; break;
+    case 2:
+        days_in_month = ((tm_info->tm_year + 1900) % 4 == 0) ? 29 : 28;
+        break;
+    default: days_in_month = 31;
+    }
 
-        for (int i = 0; i < day_of_week; i++) {
-            printf("   ");
+    int row = 5;
+    for (int day = 1; day <= days_in_month; day++) {
+        int column = (day - 1 + day_of_week) % 7;
+        term_print(column * 3, row, TERM_DEFAULT, "%2d", day);
+        if (column == 6) {
+            row++;
         }
+    }
 
-        for (int day = 1; day <= days_in_month; day++) {
-            printf("%2d ", day);
-            if ((day + day_of_week) % 7 == 0 || day == days_in_month) {
-                printf("\n");
-            }
-        }
+    term_print(0, 12, TERM_DEFAULT, "Press 'q' to quit...");
+    term_present();
+}
 
-        printf("\nPress 'q' to quit...");
-        if (kbhit()) {
-            char ch = getchar();
-            if (ch == 'q' || ch == 'Q') {
-                break;
-            }
-        }
+static void calendar_on_tick(EventLoop* loop, uint64_t expirations, void* arg) {
+    (void)loop; (void)expirations; (void)arg;
+    draw_calendar();
+}
 
-        sleep(1);
+static void calendar_on_key(EventLoop* loop, int key, void* arg) {
+    (void)arg;
+    if (key == 'q' || key == 'Q' || key == EVLOOP_KEY_EOF) {
+        evloop_stop(loop);
     }
 }
 
+void calendar() {
+    EventLoop loop;
+
+    term_init(40, 14);
+    if (screen_loop_init(&loop, calendar_on_key, calendar_on_tick, 1000, NULL) == 0) {
+        draw_calendar();
+        evloop_run(&loop);
+    }
+    evloop_destroy(&loop);
+    term_shutdown();
+}
+
 void create_file() {
     clear_screen();
     printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
@@ -1094,197 +1137,454 @@ void file_info() {
     getchar(); getchar();
 }
 
-void minesweeper() {
-    clear_screen();
-    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("%s            MINESWEEPER%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("A simplified version of Minesweeper\n\n");
+#define MINES_DEFAULT_SIZE 5
+#define MINES_DEFAULT_COUNT 5
+#define MINES_VIEW_ROWS 20   // Largest part of the board printed at once
+#define MINES_VIEW_COLS 40
 
-    const int SIZE = 5;
-    const int MINES = 5;
+// Print the part of the board around (center_row, center_col) that fits the view
+void print_mine_board(MineBoard* board, int center_row, int center_col, int show_all) {
+    int rows = board->height < MINES_VIEW_ROWS ? board->height : MINES_VIEW_ROWS;
+    int cols = board->width < MINES_VIEW_COLS ? board->width : MINES_VIEW_COLS;
+    int top = center_row - rows / 2, left = center_col - cols / 2;
 
-    char board[SIZE][SIZE];
-    char visible[SIZE][SIZE];
+    if (top > board->height - rows) top = board->height - rows;
+    if (left > board->width - cols) left = board->width - cols;
+    if (top < 0) top = 0;
+    if (left < 0) left = 0;
 
-    for (int i = 0; i < SIZE; i++) {
-        for (int j = 0; j < SIZE; j++) {
-            board[i][j] = '0';
-            visible[i][j] = '.';
+    if (rows < board->height || cols < board->width) {
+        printf("Rows %d-%d, columns %d-%d of %dx%d\n",
+            top, top + rows - 1, left, left + cols - 1, board->height, board->width);
+    }
+
+    int label = snprintf(NULL, 0, "%d", top + rows - 1);
+    printf("%*s  ", label, "");
+    for (int j = 0; j < cols; j++) printf("%d ", (left + j) % 10);
+    printf("\n");
+
+    for (int i = top; i < top + rows; i++) {
+        printf("%*d |", label, i);
+        for (int j = left; j < left + cols; j++) {
+            char cell;
+            if (show_all || mines_bit(board->revealed, board, j, i)) {
+                cell = mines_bit(board->mines, board, j, i) ? '*' : (char)('0' + mines_neighbours(board, j, i));
+            }
+            else {
+                cell = mines_bit(board->flagged, board, j, i) ? 'F' : '.';
+            }
+            printf("%c ", cell);
         }
+        printf("\n");
     }
+}
 
-    srand(time(NULL));
-    for (int m = 0; m < MINES; ) {
-        int x = rand() % SIZE;
-        int y = rand() % SIZE;
+void minesweeper() {
+    clear_screen();
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s            MINESWEEPER%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
 
-        if (board[x][y] != '*') {
-            board[x][y] = '*';
-            m++;
+    int rows, cols, mines;
+    printf("Board size and mines (rows cols mines, 0 0 0 for %dx%d with %d): ",
+        MINES_DEFAULT_SIZE, MINES_DEFAULT_SIZE, MINES_DEFAULT_COUNT);
+    if (scanf("%d %d %d", &rows, &cols, &mines) != 3) {
+        print_error("Invalid input!");
+        while (getchar() != '\n'); // Clear input buffer
+        return;
+    }
+    while (getchar() != '\n'); // Clear input buffer
 
-            for (int i = -1; i <= 1; i++) {
-                for (int j = -1; j <= 1; j++) {
-                    if (i == 0 && j == 0) continue;
-                    int nx = x + i;
-                    int ny = y + j;
+    if (rows <= 0 || cols <= 0) {
+        rows = cols = MINES_DEFAULT_SIZE;
+        mines = MINES_DEFAULT_COUNT;
+    }
 
-                    if (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && board[nx][ny] != '*') {
-                        board[nx][ny]++;
-                    }
-                }
-            }
-        }
+    MineBoard board;
+    if (mines_init(&board, cols, rows, mines, (uint64_t)time(NULL)) != 0) {
+        printf("Board must be between 1x1 and %dx%d!\n", MINES_MAX_SIDE, MINES_MAX_SIDE);
+        sleep(2);
+        return;
     }
 
     int game_over = 0;
-    int cells_revealed = 0;
-    int total_safe = SIZE * SIZE - MINES;
+    int last_row = rows / 2, last_col = cols / 2;
+    char line[128];
 
-    while (!game_over && cells_revealed < total_safe) {
-        printf("   ");
-        for (int i = 0; i < SIZE; i++) printf("%d ", i);
+    while (!game_over && !(board.placed && board.safe_left == 0)) {
         printf("\n");
+        print_mine_board(&board, last_row, last_col, 0);
 
-        for (int i = 0; i < SIZE; i++) {
-            printf("%d |", i);
-            for (int j = 0; j < SIZE; j++) {
-                printf("%c ", visible[i][j]);
-            }
-            printf("\n");
+        printf("\nEnter row and column (0-%d, 0-%d), 'f row col' to flag, 'q' to quit: ", rows - 1, cols - 1);
+        if (fgets(line, sizeof(line), stdin) == NULL || line[0] == 'q') {
+            break;
         }
 
         int x, y;
-        printf("\nEnter row and column (0-%d): ", SIZE - 1);
-        scanf("%d %d", &x, &y);
-
-        if (x < 0 || x >= SIZE || y < 0 || y >= SIZE) {
+        int flag = line[0] == 'f';
+        if (sscanf(flag ? line + 1 : line, "%d %d", &y, &x) != 2 ||
+            x < 0 || x >= cols || y < 0 || y >= rows) {
             printf("Invalid coordinates!\n");
             continue;
         }
+        last_row = y;
+        last_col = x;
 
-        if (visible[x][y] != '.') {
-            printf("Cell already revealed!\n");
+        if (flag) {
+            mines_toggle_flag(&board, x, y);
             continue;
         }
 
-        if (board[x][y] == '*') {
+        struct timespec start, end;
+        long opened;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        MinesResult result = mines_reveal(&board, x, y, &opened);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (result == MINES_BOOM) {
             game_over = 1;
-            visible[x][y] = '*';
         }
-        else {
-            visible[x][y] = board[x][y];
-            cells_revealed++;
+        else if (result == MINES_SKIPPED) {
+            printf("Cell already revealed!\n");
+        }
+        else if (opened > 1) {
+            printf("Opened %ld cells in %.3f ms\n", opened,
+                (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6);
         }
     }
 
     if (game_over) {
         printf("\nBOOM! You hit a mine!\n");
     }
-    else {
+    else if (board.placed && board.safe_left == 0) {
         printf("\nCongratulations! You cleared the minefield!\n");
     }
 
     printf("\nFinal Board:\n");
-    printf("   ");
-    for (int i = 0; i < SIZE; i++) printf("%d ", i);
-    printf("\n");
+    if (!board.placed) mines_place(&board, last_col, last_row);
+    print_mine_board(&board, last_row, last_col, 1);
+    mines_free(&board);
 
-    for (int i = 0; i < SIZE; i++) {
-        printf("%d |", i);
-        for (int j = 0; j < SIZE; j++) {
-            printf("%c ", board[i][j]);
-        }
-        printf("\n");
+    printf("\nPress any key to continue...");
+    getchar();
+}
+
+// Standard Minesweeper difficulties used by the benchmark
+static const struct {
+    const char* name;
+    int width, height, mines;
+} mine_presets[] = {
+    { "beginner", 9, 9, 10 },
+    { "intermediate", 16, 16, 40 },
+    { "expert", 30, 16, 99 },
+};
+
+void print_mine_benchmark(MinesBenchConfig* config, MinesBenchResult* result) {
+    printf("%s--------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("Board:        %dx%d with %d mines\n", config->width, config->height, config->mines);
+    printf("Games:        %ld on %d threads\n", result->games, result->threads);
+    printf("Wins:         %ld (%.2f%%)\n", result->wins,
+        result->games ? 100.0 * result->wins / result->games : 0.0);
+    printf("Guesses/game: %.2f\n", result->games ? (double)result->guesses / result->games : 0.0);
+    printf("Elapsed:      %.3f s\n", result->seconds);
+    printf("Throughput:   %.0f games/s\n", result->seconds > 0 ? result->games / result->seconds : 0.0);
+    printf("%s--------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
+}
+
+void mine_benchmark() {
+    clear_screen();
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s          MINE BENCHMARK%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+
+    MinesBenchConfig config;
+    int preset;
+    memset(&config, 0, sizeof(config));
+
+    printf("1. Beginner (9x9, 10 mines)\n");
+    printf("2. Intermediate (16x16, 40 mines)\n");
+    printf("3. Expert (30x16, 99 mines)\n");
+    printf("Select board: ");
+    if (scanf("%d", &preset) != 1 || preset < 1 || preset > 3) {
+        print_error("Invalid choice!");
+        while (getchar() != '\n'); // Clear input buffer
+        sleep(1);
+        return;
+    }
+    printf("Games to play: ");
+    if (scanf("%ld", &config.games) != 1 || config.games <= 0) {
+        print_error("Invalid input!");
+        while (getchar() != '\n'); // Clear input buffer
+        sleep(1);
+        return;
+    }
+    printf("Threads (0 for all cores): ");
+    if (scanf("%d", &config.threads) != 1) {
+        config.threads = 0;
+    }
+    while (getchar() != '\n'); // Clear input buffer
+
+    config.width = mine_presets[preset - 1].width;
+    config.height = mine_presets[preset - 1].height;
+    config.mines = mine_presets[preset - 1].mines;
+    config.seed = (uint64_t)time(NULL);
+
+    print_info("Solving games...");
+    MinesBenchResult result;
+    if (mines_benchmark(&config, &result) != 0) {
+        print_error("Benchmark failed to run!");
+    }
+    else {
+        print_mine_benchmark(&config, &result);
     }
 
     printf("\nPress any key to continue...");
-    getchar(); getchar();
+    getchar();
 }
 
+// Notes from beep_sound land here while the music player is rendering
+SynthOutput* current_audio = NULL;
+
 void music_player() {
+    char path[MAX_PATH_LENGTH];
+
     clear_screen();
     printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
     printf("%s            MUSIC PLAYER%s\n", COLOR_AQUA, COLOR_RESET);
     printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("Playing background music...\n");
+    printf("Enter output WAV file (default music.wav): ");
+    if (fgets(path, sizeof(path), stdin) == NULL) path[0] = '\0';
+    if (path[0] == '\n' && fgets(path, sizeof(path), stdin) == NULL) path[0] = '\0';
+    path[strcspn(path, "\n")] = '\0';
+    if (path[0] == '\0') strcpy(path, "music.wav");
+
+    SynthOutput output;
+    if (synth_open(&output, path) != 0) {
+        print_error("Cannot open audio output!");
+        sleep(2);
+        return;
+    }
 
-    for (int i = 0; i < 5; i++) {
-        if (task_count == 0 || !tasks[task_count - 1].is_running) break;
+    printf("Rendering background music...\n");
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
 
+    current_audio = &output;
+    for (int i = 0; i < 5; i++) {
         printf("Playing note %d/5...\n", i + 1);
         beep_sound(500, 440 + i * 100);
-        sleep(1);
+        beep_sound(500, 0);   // Rest between notes
     }
+    current_audio = NULL;
 
-    printf("Music finished playing.\n");
+    int failed = synth_close(&output) != 0;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double audio = (double)output.samples_written / SYNTH_SAMPLE_RATE;
+
+    if (failed) {
+        print_error("Writing the audio failed!");
+    }
+    else {
+        printf("Music finished: %.1f s of audio written to %s\n", audio, path);
+        printf("Rendered in %.2f ms (%.0fx real time)\n", seconds * 1000.0, seconds > 0 ? audio / seconds : 0.0);
+    }
     sleep(2);
 }
 
+void print_synth_benchmark(SynthBenchResult* result) {
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s          SYNTH BENCHMARK%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("Audio rendered:  %.1f s (%ld samples)\n", (double)result->samples / SYNTH_SAMPLE_RATE, result->samples);
+    printf("Wall time:       %.3f s\n", result->seconds);
+    printf("Throughput:      %.1f M samples/s\n", result->samples_per_sec / 1e6);
+    printf("Real-time:       %.0fx\n", result->realtime_factor);
+}
+
+// Called by the history sampler thread
+void sample_system(HistorySample* sample, void* arg) {
+    (void)arg;
+
+    sem_wait(&resource_sem);
+    SystemResources res = system_res;
+    sem_post(&resource_sem);
+
+    if (res.total_ram > 0) sample->values[HIST_RAM] = (float)(res.total_ram - res.available_ram) / res.total_ram * 100;
+    if (res.total_hdd > 0) sample->values[HIST_HDD] = (float)(res.total_hdd - res.available_hdd) / res.total_hdd * 100;
+    if (res.total_cores > 0) sample->values[HIST_CPU] = (float)(res.total_cores - res.available_cores) / res.total_cores * 100;
+
+    int runnable = 0;
+    pthread_mutex_lock(&queue_mutex);
+    for (int i = 0; i < task_count; i++) {
+        if (tasks[i].is_running) runnable++;
+    }
+    pthread_mutex_unlock(&queue_mutex);
+    sample->values[HIST_RUN_QUEUE] = (float)runnable;
+}
+
+#define MONITOR_SPARK_WIDTH 40
+#define MONITOR_REFRESH_MS 250
+
+// History windows the monitor can show; 0 means the whole ring
+static const struct {
+    const char* name;
+    long window_ms;
+} monitor_windows[] = {
+    { "last 10 s", 10000 },
+    { "last 1 min", 60000 },
+    { "whole history", 0 },
+};
+
+static const struct {
+    const char* label;
+    HistoryMetric metric;
+    int percent;   // Scaled to 100, otherwise to the window maximum
+} monitor_rows[] = {
+    { "RAM %", HIST_RAM, 1 },
+    { "HDD %", HIST_HDD, 1 },
+    { "CPU %", HIST_CPU, 1 },
+    { "RunQ", HIST_RUN_QUEUE, 0 },
+    { "Starts", HIST_STARTS, 0 },
+    { "Exits", HIST_EXITS, 0 },
+};
+
+int monitor_window = 0;
+HistorySample monitor_samples[HISTORY_CAPACITY];
+
+void draw_system_monitor() {
+    term_clear();
+    term_print(0, 0, TERM_AQUA, "======================================");
+    term_print(0, 1, TERM_AQUA, "          SYSTEM MONITOR");
+    term_print(0, 2, TERM_AQUA, "======================================");
+
+    term_print(0, 4, TERM_DEFAULT, "System Resources:");
+    term_print(0, 5, TERM_AQUA, "--------------------------------------");
+    term_print(0, 6, TERM_DEFAULT, "RAM: %d/%d MB (%.1f%% used)",
+        system_res.total_ram - system_res.available_ram,
+        system_res.total_ram,
+        ((float)(system_res.total_ram - system_res.available_ram) / system_res.total_ram * 100));
+    term_print(0, 7, TERM_DEFAULT, "HDD: %d/%d MB (%.1f%% used)",
+        system_res.total_hdd - system_res.available_hdd,
+        system_res.total_hdd,
+        ((float)(system_res.total_hdd - system_res.available_hdd) / system_res.total_hdd * 100));
+    term_print(0, 8, TERM_DEFAULT, "CPU Cores: %d/%d in use",
+        system_res.total_cores - system_res.available_cores,
+        system_res.total_cores);
+    term_print(0, 9, TERM_AQUA, "--------------------------------------");
+
+    long window_ms = monitor_windows[monitor_window].window_ms;
+    if (window_ms == 0) window_ms = (long)HISTORY_CAPACITY * history.interval_ms;
+    long n = history_snapshot(&history, window_ms, monitor_samples, HISTORY_CAPACITY);
+
+    term_print(0, 11, TERM_DEFAULT, "History (%s, %ld samples every %ld ms):",
+        monitor_windows[monitor_window].name, n, history.interval_ms);
+    term_print(0, 12, TERM_AQUA, "%-7s %-*s %6s %6s %6s %6s", "", MONITOR_SPARK_WIDTH + 2, "", "now", "min", "avg", "max");
+
+    for (size_t r = 0; r < sizeof(monitor_rows) / sizeof(monitor_rows[0]); r++) {
+        HistoryStats stats;
+        char spark[MONITOR_SPARK_WIDTH + 1];
+        int y = 13 + (int)r;
+
+        history_stats(monitor_samples, n, monitor_rows[r].metric, &stats);
+        float max = monitor_rows[r].percent ? 100.0f : (stats.max > 1.0f ? stats.max : 1.0f);
+        history_sparkline(monitor_samples, n, monitor_rows[r].metric, max, spark, MONITOR_SPARK_WIDTH);
+
+        term_print(0, y, TERM_DEFAULT, "%-7s", monitor_rows[r].label);
+        term_print(8, y, TERM_AQUA, "|");
+        term_print(9, y, TERM_GREEN, "%s", spark);
+        term_print(9 + MONITOR_SPARK_WIDTH, y, TERM_AQUA, "|");
+        term_print(11 + MONITOR_SPARK_WIDTH, y, TERM_DEFAULT, "%6.1f %6.1f %6.1f %6.1f",
+            stats.last, stats.min, stats.avg, stats.max);
+    }
+
+    term_print(0, 20, TERM_DEFAULT, "Press w to change the window, q to quit...");
+    term_present();
+}
+
+static void system_monitor_on_tick(EventLoop* loop, uint64_t expirations, void* arg) {
+    (void)loop; (void)expirations; (void)arg;
+    draw_system_monitor();
+}
+
+static void system_monitor_on_key(EventLoop* loop, int key, void* arg) {
+    (void)arg;
+    if (key == 'q' || key == EVLOOP_KEY_EOF) {
+        evloop_stop(loop);
+    }
+    else {
+        if (key == 'w') monitor_window = (monitor_window + 1) % (int)(sizeof(monitor_windows) / sizeof(monitor_windows[0]));
+        draw_system_monitor();
+    }
+}
+
 void system_monitor() {
-    while (1) {
-        clear_screen();
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s          SYSTEM MONITOR%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    EventLoop loop;
 
-        printf("\nSystem Resources:\n");
-        printf("%s--------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("RAM: %d/%d MB (%.1f%% used)\n",
-            system_res.total_ram - system_res.available_ram,
-            system_res.total_ram,
-            ((float)(system_res.total_ram - system_res.available_ram) / system_res.total_ram * 100));
-        printf("HDD: %d/%d MB (%.1f%% used)\n",
-            system_res.total_hdd - system_res.available_hdd,
-            system_res.total_hdd,
-            ((float)(system_res.total_hdd - system_res.available_hdd) / system_res.total_hdd * 100));
-        printf("CPU Cores: %d/%d in use\n",
-            system_res.total_cores - system_res.available_cores,
-            system_res.total_cores);
-        printf("%s--------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
+    term_init(80, 22);
+    if (screen_loop_init(&loop, system_monitor_on_key, system_monitor_on_tick, MONITOR_REFRESH_MS, NULL) == 0) {
+        draw_system_monitor();
+        evloop_run(&loop);
+    }
+    evloop_destroy(&loop);
+    term_shutdown();
+}
 
-        printf("\nPress q to quit or any other key to refresh...");
-        char ch = getchar();
-        if (ch == 'q') {
-            break;
+void draw_process_manager() {
+    term_clear();
+    term_print(0, 0, TERM_AQUA, "======================================");
+    term_print(0, 1, TERM_AQUA, "          PROCESS MANAGER");
+    term_print(0, 2, TERM_AQUA, "======================================");
+
+    int row = 3;
+    if (task_count == 0) {
+        term_print(0, row++, TERM_DEFAULT, "No processes running.");
+    }
+    else {
+        term_print(0, row++, TERM_DEFAULT, "%-5s %-20s %-10s %-10s %-10s %-10s",
+            "ID", "Name", "RAM(MB)", "HDD(MB)", "CPU", "Status");
+        term_print(0, row++, TERM_AQUA, "------------------------------------------------------------");
+
+        for (int i = 0; i < task_count && row < term_height() - 2; i++) {
+            term_print(0, row++, TERM_DEFAULT, "%-5d %-20s %-10d %-10d %-10d %-10s",
+                i,
+                tasks[i].name,
+                tasks[i].ram_usage,
+                tasks[i].hdd_usage,
+                tasks[i].cpu_usage,
+                tasks[i].is_minimized ? "Minimized" : "Running");
         }
-        while ((getchar()) != '\n'); // Clear input buffer
     }
+
+    term_print(0, row + 1, TERM_DEFAULT, "Press q to quit or any other key to refresh...");
+    term_present();
 }
 
-void process_manager() {
-    while (1) {
-        clear_screen();
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s          PROCESS MANAGER%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+static void process_manager_on_tick(EventLoop* loop, uint64_t expirations, void* arg) {
+    (void)loop; (void)expirations; (void)arg;
+    draw_process_manager();
+}
 
-        if (task_count == 0) {
-            printf("No processes running.\n");
-        }
-        else {
-            printf("%-5s %-20s %-10s %-10s %-10s %-10s\n",
-                "ID", "Name", "RAM(MB)", "HDD(MB)", "CPU", "Status");
-            printf("%s------------------------------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
+static void process_manager_on_key(EventLoop* loop, int key, void* arg) {
+    (void)arg;
+    if (key == 'q' || key == EVLOOP_KEY_EOF) {
+        evloop_stop(loop);
+    }
+    else {
+        draw_process_manager();
+    }
+}
 
-            for (int i = 0; i < task_count; i++) {
-                printf("%-5d %-20s %-10d %-10d %-10d %-10s\n",
-                    i,
-                    tasks[i].name,
-                    tasks[i].ram_usage,
-                    tasks[i].hdd_usage,
-                    tasks[i].cpu_usage,
-                    tasks[i].is_minimized ? "Minimized" : "Running");
-            }
-        }
+void process_manager() {
+    EventLoop loop;
 
-        printf("\nPress q to quit or any other key to refresh...");
-        char ch = getchar();
-        if (ch == 'q') {
-            break;
-        }
-        while ((getchar()) != '\n'); // Clear input buffer
+    term_init(70, MAX_TASKS + 7);
+    if (screen_loop_init(&loop, process_manager_on_key, process_manager_on_tick, 1000, NULL) == 0) {
+        draw_process_manager();
+        evloop_run(&loop);
     }
+    evloop_destroy(&loop);
+    term_shutdown();
 }
 
 void memory_viewer() {
@@ -1311,116 +1611,345 @@ void memory_viewer() {
     getchar(); getchar();
 }
 
-int kbhit() {
-    struct timeval tv = { 0L, 0L };
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(STDIN_FILENO, &fds);
-    return select(1, &fds, NULL, NULL, &tv) > 0;
+void print_usage(char* program) {
+    printf("Usage: %s [mode]\n", program);
+    printf("  (no mode)                                  Start the interactive simulator\n");
+    printf("  --mines-bench [games] [threads] [board]    Benchmark the Minesweeper solver\n");
+    printf("                                             board: beginner, intermediate or expert\n");
+    printf("  --synth-wav FILE                           Render the music player's song to a WAV file (- for stdout)\n");
+    printf("  --synth-bench [seconds]                    Benchmark the synthesizer (default 600 s of audio)\n");
 }
 
-void snake_game() {
-    clear_screen();
-    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("%s             SNAKE GAME%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-    printf("Use WASD keys to move. Press q to quit.\n");
+int run_command_line(int argc, char* argv[]) {
+    if (strcmp(argv[1], "--mines-bench") == 0) {
+        MinesBenchConfig config;
+        MinesBenchResult result;
+        memset(&config, 0, sizeof(config));
+
+        config.games = argc > 2 ? atol(argv[2]) : 1000000;
+        config.threads = argc > 3 ? atoi(argv[3]) : 0;
+        config.width = mine_presets[2].width;
+        config.height = mine_presets[2].height;
+        config.mines = mine_presets[2].mines;
+        config.seed = 1;
+
+        if (argc > 4) {
+            int found = 0;
+            for (size_t i = 0; i < sizeof(mine_presets) / sizeof(mine_presets[0]); i++) {
+                if (strcmp(argv[4], mine_presets[i].name) == 0) {
+                    config.width = mine_presets[i].width;
+                    config.height = mine_presets[i].height;
+                    config.mines = mine_presets[i].mines;
+                    found = 1;
+                }
+            }
+            if (!found) {
+                print_error("Unknown board!");
+                return 1;
+            }
+        }
+        if (config.games <= 0) {
+            print_error("Number of games must be positive!");
+            return 1;
+        }
 
-    const int WIDTH = 20;
-    const int HEIGHT = 10;
+        if (mines_benchmark(&config, &result) != 0) {
+            print_error("Benchmark failed to run!");
+            return 1;
+        }
+        print_mine_benchmark(&config, &result);
+        return 0;
+    }
 
-    int snakeX[100], snakeY[100];
-    int snakeLength = 1;
-    snakeX[0] = WIDTH / 2;
-    snakeY[0] = HEIGHT / 2;
+    if (strcmp(argv[1], "--synth-wav") == 0) {
+        SynthNote song[10];
+        SynthOutput output;
 
-    int foodX = rand() % (WIDTH - 2) + 1;
-    int foodY = rand() % (HEIGHT - 2) + 1;
+        if (argc < 3) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        for (int i = 0; i < 5; i++) {
+            song[2 * i].frequency = 440 + i * 100;
+            song[2 * i].duration_ms = 500;
+            song[2 * i].amplitude = 0.8f;
+            song[2 * i + 1].frequency = 0;
+            song[2 * i + 1].duration_ms = 500;
+            song[2 * i + 1].amplitude = 0.0f;
+        }
 
-    char direction = 'd';
-    int game_over = 0;
-    struct termios oldt, newt;
+        if (synth_open(&output, argv[2]) != 0) {
+            print_error("Cannot open audio output!");
+            return 1;
+        }
+        synth_play(&output, song, 10, NULL);
+        if (synth_close(&output) != 0) {
+            print_error("Writing the audio failed!");
+            return 1;
+        }
+        return 0;
+    }
 
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
+    if (strcmp(argv[1], "--synth-bench") == 0) {
+        SynthBenchResult result;
+        double seconds = argc > 2 ? atof(argv[2]) : 600.0;
 
-    while (!game_over) {
-        clear_screen();
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s             SNAKE GAME%s\n", COLOR_AQUA, COLOR_RESET);
-        printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
-
-        for (int i = 0; i < HEIGHT; i++) {
-            for (int j = 0; j < WIDTH; j++) {
-                if (i == 0 || i == HEIGHT - 1 || j == 0 || j == WIDTH - 1) {
-                    printf("#");
-                }
-                else if (i == foodY && j == foodX) {
-                    printf("F");
-                }
-                else {
-                    int isSnake = 0;
-                    for (int k = 0; k < snakeLength; k++) {
-                        if (snakeX[k] == j && snakeY[k] == i) {
-                            printf("O");
-                            isSnake = 1;
-                            break;
-                        }
-                    }
-                    if (!isSnake) printf(" ");
-                }
-            }
-            printf("\n");
+        if (seconds <= 0) {
+            print_error("Audio length must be positive!");
+            return 1;
         }
-
-        if (kbhit()) {
-            char ch = getchar();
-            switch (ch) {
-            case 'w': if (direction != 's') direction = 'w'; break;
-            case 'a': if (direction != 'd') direction = 'a'; break;
-            case 's': if (direction != 'w') direction = 's'; break;
-            case 'd': if (direction != 'a') direction = 'd'; break;
-            case 'q': game_over = 1; continue;
-            }
+        if (synth_benchmark(seconds, &result) != 0) {
+            print_error("Benchmark failed to run!");
+            return 1;
         }
+        print_synth_benchmark(&result);
+        return 0;
+    }
 
-        for (int i = snakeLength - 1; i > 0; i--) {
-            snakeX[i] = snakeX[i - 1];
-            snakeY[i] = snakeY[i - 1];
-        }
+    print_usage(argv[0]);
+    return strcmp(argv[1], "--help") == 0 ? 0 : 1;
+}
 
-        switch (direction) {
-        case 'w': snakeY[0]--; break;
-        case 'a': snakeX[0]--; break;
-        case 's': snakeY[0]++; break;
-        case 'd': snakeX[0]++; break;
-        }
+// Ctrl+C leaves the current screen instead of the simulator; a resize repaints everything
+static void screen_on_signal(EventLoop* loop, int signo, void* arg) {
+    (void)arg;
+    if (signo == SIGINT) {
+        evloop_stop(loop);
+    }
+    else {
+        term_invalidate();
+    }
+}
 
-        if (snakeX[0] <= 0 || snakeX[0] >= WIDTH - 1 ||
-            snakeY[0] <= 0 || snakeY[0] >= HEIGHT - 1) {
-            game_over = 1;
+int screen_loop_init(EventLoop* loop, EventKeyCallback on_key, EventTimerCallback on_tick, long interval_ms, void* arg) {
+    if (evloop_init(loop) != 0) return -1;
+
+    if (evloop_add_stdin(loop, on_key, arg) < 0 ||
+        evloop_add_timer(loop, interval_ms, on_tick, arg) < 0 ||
+        evloop_add_signal(loop, SIGINT, screen_on_signal, NULL) < 0 ||
+        evloop_add_signal(loop, SIGWINCH, screen_on_signal, NULL) < 0) {
+        print_error("Failed to set up screen events!");
+        return -1;
+    }
+    return 0;
+}
+
+#define SNAKE_DEFAULT_WIDTH 18    // Playfield of the original 20x10 board inside its walls
+#define SNAKE_DEFAULT_HEIGHT 8
+#define SNAKE_TICK_MS 200         // Fixed simulation timestep
+#define SNAKE_FRAME_MS 33         // Frame pacing, independent of the tick rate
+#define SNAKE_MAX_CATCHUP 5       // Most ticks replayed after the loop stalls
+#define SNAKE_TOP 4               // Screen row of the first board row
+
+// Snake engine plus the part of the board currently shown on screen
+typedef struct {
+    SnakeGame engine;
+    int view_x, view_y;   // Board cell shown at the viewport's top-left corner
+    int view_w, view_h;   // Viewport size in cells
+    int dirty;            // Back buffer changed since the last present
+    int over;
+    SnakeResult result;
+} SnakeScreen;
+
+void draw_snake_cell(SnakeScreen* screen, int cell) {
+    SnakeGame* game = &screen->engine;
+    int x = cell % game->width - screen->view_x;
+    int y = cell / game->width - screen->view_y;
+
+    if (cell < 0 || x < 0 || y < 0 || x >= screen->view_w || y >= screen->view_h) return;
+
+    if (snake_is_occupied(game, cell)) {
+        term_put(x + 1, y + SNAKE_TOP, 'O', TERM_GREEN);
+    }
+    else if (cell == game->food) {
+        term_put(x + 1, y + SNAKE_TOP, 'F', TERM_RED);
+    }
+    else {
+        term_put(x + 1, y + SNAKE_TOP, ' ', TERM_DEFAULT);
+    }
+}
+
+// Repaint the whole viewport; only needed when it scrolls or the game starts
+void draw_snake_board(SnakeScreen* screen) {
+    SnakeGame* game = &screen->engine;
+
+    term_clear();
+    term_print(0, 0, TERM_AQUA, "======================================");
+    term_print(0, 1, TERM_AQUA, "             SNAKE GAME");
+    term_print(0, 2, TERM_AQUA, "======================================");
+
+    // Walls are solid where the board ends and dotted where it continues off screen
+    char top = screen->view_y == 0 ? '#' : '.';
+    char bottom = screen->view_y + screen->view_h == game->height ? '#' : '.';
+    char left = screen->view_x == 0 ? '#' : '.';
+    char right = screen->view_x + screen->view_w == game->width ? '#' : '.';
+
+    for (int x = 0; x < screen->view_w + 2; x++) {
+        term_put(x, SNAKE_TOP - 1, top, TERM_DEFAULT);
+        term_put(x, SNAKE_TOP + screen->view_h, bottom, TERM_DEFAULT);
+    }
+    for (int y = 0; y < screen->view_h; y++) {
+        term_put(0, SNAKE_TOP + y, left, TERM_DEFAULT);
+        term_put(screen->view_w + 1, SNAKE_TOP + y, right, TERM_DEFAULT);
+
+        int row = (screen->view_y + y) * game->width + screen->view_x;
+        for (int x = 0; x < screen->view_w; x++) {
+            draw_snake_cell(screen, row + x);
         }
+    }
+    screen->dirty = 1;
+}
 
-        for (int i = 1; i < snakeLength; i++) {
-            if (snakeX[0] == snakeX[i] && snakeY[0] == snakeY[i]) {
-                game_over = 1;
-            }
+void draw_snake_status(SnakeScreen* screen) {
+    TermStats frame_stats;
+    int row = SNAKE_TOP + screen->view_h + 1;
+
+    term_get_stats(&frame_stats);
+    term_print(0, row, TERM_YELLOW, "Score: %d  Board: %dx%d  FPS: %.1f  Frame: %.1f us        ",
+        screen->engine.score, screen->engine.width, screen->engine.height,
+        frame_stats.fps, frame_stats.last_present_ns / 1000.0);
+    term_print(0, row + 1, TERM_DEFAULT, "Use WASD keys to move. Press q to quit.");
+}
+
+// Scroll the viewport when the head gets close to its edge; returns 1 if it moved
+int snake_follow_head(SnakeScreen* screen) {
+    SnakeGame* game = &screen->engine;
+    int head = snake_head(game);
+    int hx = head % game->width, hy = head / game->width;
+    int margin_x = screen->view_w / 4, margin_y = screen->view_h / 4;
+    int view_x = screen->view_x, view_y = screen->view_y;
+
+    if (hx < view_x + margin_x || hx >= view_x + screen->view_w - margin_x) {
+        view_x = hx - screen->view_w / 2;
+    }
+    if (hy < view_y + margin_y || hy >= view_y + screen->view_h - margin_y) {
+        view_y = hy - screen->view_h / 2;
+    }
+
+    if (view_x > game->width - screen->view_w) view_x = game->width - screen->view_w;
+    if (view_y > game->height - screen->view_h) view_y = game->height - screen->view_h;
+    if (view_x < 0) view_x = 0;
+    if (view_y < 0) view_y = 0;
+
+    if (view_x == screen->view_x && view_y == screen->view_y) return 0;
+    screen->view_x = view_x;
+    screen->view_y = view_y;
+    return 1;
+}
+
+static void snake_on_key(EventLoop* loop, int key, void* arg) {
+    SnakeScreen* screen = arg;
+
+    switch (key) {
+    case 'w': snake_turn(&screen->engine, SNAKE_UP); break;
+    case 'a': snake_turn(&screen->engine, SNAKE_LEFT); break;
+    case 's': snake_turn(&screen->engine, SNAKE_DOWN); break;
+    case 'd': snake_turn(&screen->engine, SNAKE_RIGHT); break;
+    case 'q':
+    case EVLOOP_KEY_EOF:
+        screen->over = 1;
+        evloop_stop(loop);
+        break;
+    }
+}
+
+// Fixed timestep: every expiration is one step, even if the loop was late
+static void snake_on_tick(EventLoop* loop, uint64_t expirations, void* arg) {
+    SnakeScreen* screen = arg;
+    SnakeGame* game = &screen->engine;
+
+    if (expirations > SNAKE_MAX_CATCHUP) expirations = SNAKE_MAX_CATCHUP;
+
+    for (uint64_t i = 0; i < expirations && !screen->over; i++) {
+        screen->result = snake_step(game);
+        if (screen->result == SNAKE_CRASHED || screen->result == SNAKE_WON) {
+            screen->over = 1;
+            break;
         }
 
-        if (snakeX[0] == foodX && snakeY[0] == foodY) {
-            snakeLength++;
-            foodX = rand() % (WIDTH - 2) + 1;
-            foodY = rand() % (HEIGHT - 2) + 1;
+        if (snake_follow_head(screen)) {
+            draw_snake_board(screen);
         }
+        else {
+            draw_snake_cell(screen, game->vacated);
+            draw_snake_cell(screen, snake_head(game));
+            draw_snake_cell(screen, game->food);
+            screen->dirty = 1;
+        }
+    }
+
+    if (screen->over) {
+        draw_snake_status(screen);
+        term_present();
+        evloop_stop(loop);
+    }
+}
+
+// Rendering runs on its own clock and only presents frames that changed
+static void snake_on_frame(EventLoop* loop, uint64_t expirations, void* arg) {
+    SnakeScreen* screen = arg;
+    (void)loop; (void)expirations;
+
+    if (!screen->dirty) return;
+    draw_snake_status(screen);
+    term_present();
+    screen->dirty = 0;
+}
+
+void snake_game() {
+    clear_screen();
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s             SNAKE GAME%s\n", COLOR_AQUA, COLOR_RESET);
+    printf("%s======================================%s\n", COLOR_AQUA, COLOR_RESET);
+
+    int width, height;
+    printf("Board size (width height, 0 0 for %dx%d): ", SNAKE_DEFAULT_WIDTH, SNAKE_DEFAULT_HEIGHT);
+    if (scanf("%d %d", &width, &height) != 2) {
+        print_error("Invalid input!");
+        while (getchar() != '\n'); // Clear input buffer
+        return;
+    }
+    while (getchar() != '\n'); // Clear input buffer
 
-        usleep(200000);
+    if (width <= 0 || height <= 0) {
+        width = SNAKE_DEFAULT_WIDTH;
+        height = SNAKE_DEFAULT_HEIGHT;
     }
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
+    SnakeScreen screen;
+    memset(&screen, 0, sizeof(screen));
+    if (snake_init(&screen.engine, width, height, (uint64_t)time(NULL)) != 0) {
+        printf("Board must be between 2x1 and %dx%d!\n", SNAKE_MAX_SIDE, SNAKE_MAX_SIDE);
+        sleep(2);
+        return;
+    }
+
+    // Show as much of the board as the terminal allows and scroll for the rest
+    int frame_w = width + 2 < 50 ? 50 : width + 2;
+    term_init(frame_w, height + SNAKE_TOP + 3);
+    screen.view_w = width < term_width() - 2 ? width : term_width() - 2;
+    screen.view_h = height < term_height() - SNAKE_TOP - 3 ? height : term_height() - SNAKE_TOP - 3;
+    if (screen.view_h < 1) screen.view_h = 1;
+    snake_follow_head(&screen);
+    draw_snake_board(&screen);
+
+    EventLoop loop;
+    if (screen_loop_init(&loop, snake_on_key, snake_on_tick, SNAKE_TICK_MS, &screen) == 0 &&
+        evloop_add_timer(&loop, SNAKE_FRAME_MS, snake_on_frame, &screen) >= 0) {
+        snake_on_frame(&loop, 1, &screen);
+        evloop_run(&loop);
+    }
+    evloop_destroy(&loop);
+    term_shutdown();
+
+    if (screen.result == SNAKE_WON) {
+        printf("\nYou filled the board! Your score: %d\n", screen.engine.score);
+    }
+    else {
+        printf("\nGame Over! Your score: %d\n", screen.engine.score);
+    }
+    snake_free(&screen.engine);
 
-    printf("\nGame Over! Your score: %d\n", snakeLength - 1);
     printf("Press any key to continue...");
     getchar();
 }
@@ -1453,6 +1982,7 @@ void help_system() {
     printf("18. Switch Mode - Toggle between User and Kernel mode\n");
     printf("19. Shutdown - Shuts down the OS\n");
     printf("20. Set CPU Scheduling - Change CPU scheduling algorithm\n");
+    printf("21. Mine Benchmark - Minesweeper auto-solver win rate and CPU stress test\n");
     printf("%s--------------------------------------%s\n", COLOR_AQUA, COLOR_RESET);
 
     printf("\nIn Kernel Mode, you can:\n");
@@ -1471,7 +2001,7 @@ void clear_screen() {
 #ifdef _WIN32
     system("cls");
 #else
-    system("clear");
+    term_clear_screen();
 #endif
 }
 
@@ -1519,8 +2049,14 @@ void beep_sound(int duration_ms, int frequency) {
 #ifdef _WIN32
     Beep(frequency, duration_ms);
 #else
-    char command[50];
-    sprintf(command, "beep -f %d -l %d", frequency, duration_ms);
-    system(command);
+    if (current_audio != NULL) {
+        SynthNote note = { frequency, duration_ms, frequency > 0 ? 0.8f : 0.0f };
+        synth_play(current_audio, &note, 1, NULL);
+    }
+    else if (frequency > 0) {
+        // No audio output open: the terminal bell is the best we can do
+        putchar('\a');
+        fflush(stdout);
+    }
 #endif
-}
\ No newline at end of file
+}
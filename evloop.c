@@ -0,0 +1,278 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+#include "evloop.h"
+
+static int alloc_handler(EventLoop* loop) {
+    for (int i = 0; i < EVLOOP_MAX_HANDLERS; i++) {
+        if (loop->handlers[i].type == EV_NONE) return i;
+    }
+    return -1;
+}
+
+// Put the handler's descriptor in the epoll set, keyed by its slot index
+static int watch_handler(EventLoop* loop, int id, uint32_t events) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u32 = (uint32_t)id;
+    return epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->handlers[id].fd, &ev);
+}
+
+static void restore_stdin(EventLoop* loop) {
+    if (loop->stdin_is_tty) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &loop->stdin_saved);
+        loop->stdin_is_tty = 0;
+    }
+    if (loop->stdin_flags != -1) {
+        fcntl(STDIN_FILENO, F_SETFL, loop->stdin_flags);
+        loop->stdin_flags = -1;
+    }
+}
+
+int evloop_init(EventLoop* loop) {
+    memset(loop, 0, sizeof(*loop));
+    loop->stdin_flags = -1;
+    sigemptyset(&loop->blocked);
+    pthread_sigmask(SIG_SETMASK, NULL, &loop->saved_mask);
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd == -1) {
+        perror("Failed to create event loop");
+        return -1;
+    }
+    return 0;
+}
+
+void evloop_destroy(EventLoop* loop) {
+    for (int i = 0; i < EVLOOP_MAX_HANDLERS; i++) {
+        evloop_remove(loop, i);
+    }
+
+    if (loop->epoll_fd != -1) {
+        close(loop->epoll_fd);
+        loop->epoll_fd = -1;
+    }
+
+    // Drop any signal that arrived while blocked so it is not delivered late
+    if (!sigisemptyset(&loop->blocked)) {
+        struct timespec no_wait = { 0, 0 };
+        while (sigtimedwait(&loop->blocked, NULL, &no_wait) > 0);
+        pthread_sigmask(SIG_SETMASK, &loop->saved_mask, NULL);
+        sigemptyset(&loop->blocked);
+    }
+}
+
+int evloop_add_fd(EventLoop* loop, int fd, uint32_t events, EventFdCallback cb, void* arg) {
+    int id = alloc_handler(loop);
+    if (id < 0) return -1;
+
+    EventHandler* h = &loop->handlers[id];
+    h->type = EV_FD;
+    h->fd = fd;
+    h->arg = arg;
+    h->cb.on_fd = cb;
+
+    if (watch_handler(loop, id, events) == -1) {
+        h->type = EV_NONE;
+        return -1;
+    }
+    return id;
+}
+
+int evloop_add_stdin(EventLoop* loop, EventKeyCallback cb, void* arg) {
+    int id = alloc_handler(loop);
+    if (id < 0 || loop->stdin_flags != -1) return -1;
+
+    // Keys arrive one at a time without echo and reads never block the loop
+    if (tcgetattr(STDIN_FILENO, &loop->stdin_saved) == 0) {
+        struct termios raw = loop->stdin_saved;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        loop->stdin_is_tty = 1;
+    }
+    loop->stdin_flags = fcntl(STDIN_FILENO, F_GETFL);
+    fcntl(STDIN_FILENO, F_SETFL, loop->stdin_flags | O_NONBLOCK);
+
+    EventHandler* h = &loop->handlers[id];
+    h->type = EV_STDIN;
+    h->fd = STDIN_FILENO;
+    h->arg = arg;
+    h->cb.on_key = cb;
+
+    if (watch_handler(loop, id, EPOLLIN) == -1) {
+        h->type = EV_NONE;
+        restore_stdin(loop);
+        return -1;
+    }
+    return id;
+}
+
+int evloop_add_timer(EventLoop* loop, long interval_ms, EventTimerCallback cb, void* arg) {
+    int id = alloc_handler(loop);
+    if (id < 0) return -1;
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd == -1) return -1;
+
+    EventHandler* h = &loop->handlers[id];
+    h->type = EV_TIMER;
+    h->fd = fd;
+    h->arg = arg;
+    h->cb.on_timer = cb;
+
+    if (evloop_set_timer(loop, id, interval_ms) == -1 || watch_handler(loop, id, EPOLLIN) == -1) {
+        close(fd);
+        h->type = EV_NONE;
+        return -1;
+    }
+    return id;
+}
+
+int evloop_set_timer(EventLoop* loop, int id, long interval_ms) {
+    if (id < 0 || id >= EVLOOP_MAX_HANDLERS || loop->handlers[id].type != EV_TIMER) return -1;
+
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = (interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;   // Zero disarms the timer
+    return timerfd_settime(loop->handlers[id].fd, 0, &spec, NULL);
+}
+
+int evloop_add_signal(EventLoop* loop, int signo, EventSignalCallback cb, void* arg) {
+    int id = alloc_handler(loop);
+    if (id < 0) return -1;
+
+    // The signal must be blocked or it is delivered the usual way instead of through the fd
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, signo);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    sigaddset(&loop->blocked, signo);
+
+    int fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd == -1) return -1;
+
+    EventHandler* h = &loop->handlers[id];
+    h->type = EV_SIGNAL;
+    h->fd = fd;
+    h->signo = signo;
+    h->arg = arg;
+    h->cb.on_signal = cb;
+
+    if (watch_handler(loop, id, EPOLLIN) == -1) {
+        close(fd);
+        h->type = EV_NONE;
+        return -1;
+    }
+    return id;
+}
+
+void evloop_remove(EventLoop* loop, int id) {
+    if (id < 0 || id >= EVLOOP_MAX_HANDLERS) return;
+
+    EventHandler* h = &loop->handlers[id];
+    if (h->type == EV_NONE) return;
+
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, h->fd, NULL);
+
+    switch (h->type) {
+    case EV_STDIN:
+        restore_stdin(loop);
+        break;
+    case EV_TIMER:
+    case EV_SIGNAL:
+        close(h->fd);
+        break;
+    default:
+        break;   // Plain descriptors stay owned by the caller
+    }
+
+    h->type = EV_NONE;
+}
+
+static void dispatch_stdin(EventLoop* loop, int id) {
+    EventHandler* h = &loop->handlers[id];
+    unsigned char keys[64];
+
+    ssize_t n = read(STDIN_FILENO, keys, sizeof(keys));
+    if (n == 0) {
+        // Stdin closed: report it once and stop watching, otherwise epoll keeps firing
+        EventKeyCallback cb = h->cb.on_key;
+        void* arg = h->arg;
+        evloop_remove(loop, id);
+        cb(loop, EVLOOP_KEY_EOF, arg);
+        return;
+    }
+
+    for (ssize_t i = 0; i < n && h->type == EV_STDIN; i++) {
+        h->cb.on_key(loop, keys[i], h->arg);
+    }
+}
+
+static void dispatch(EventLoop* loop, int id, uint32_t events) {
+    EventHandler* h = &loop->handlers[id];
+
+    switch (h->type) {
+    case EV_FD:
+        h->cb.on_fd(loop, h->fd, events, h->arg);
+        break;
+
+    case EV_STDIN:
+        dispatch_stdin(loop, id);
+        break;
+
+    case EV_TIMER: {
+        uint64_t expirations;
+        if (read(h->fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            h->cb.on_timer(loop, expirations, h->arg);
+        }
+        break;
+    }
+
+    case EV_SIGNAL: {
+        struct signalfd_siginfo info;
+        while (h->type == EV_SIGNAL && read(h->fd, &info, sizeof(info)) == sizeof(info)) {
+            h->cb.on_signal(loop, (int)info.ssi_signo, h->arg);
+        }
+        break;
+    }
+
+    case EV_NONE:
+        break;   // Removed by an earlier callback in the same batch
+    }
+}
+
+int evloop_run(EventLoop* loop) {
+    struct epoll_event events[EVLOOP_MAX_HANDLERS];
+
+    loop->running = 1;
+    while (loop->running) {
+        int n = epoll_wait(loop->epoll_fd, events, EVLOOP_MAX_HANDLERS, -1);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            perror("Event loop wait failed");
+            return -1;
+        }
+
+        for (int i = 0; i < n && loop->running; i++) {
+            dispatch(loop, (int)events[i].data.u32, events[i].events);
+        }
+    }
+    return 0;
+}
+
+void evloop_stop(EventLoop* loop) {
+    loop->running = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef EVLOOP_H
+#define EVLOOP_H
+
+#include <stdint.h>
+#include <signal.h>
+#include <termios.h>
+
+#define EVLOOP_MAX_HANDLERS 64
+#define EVLOOP_KEY_EOF (-1)   // Delivered to the key callback when stdin closes
+
+typedef struct EventLoop EventLoop;
+
+// Callbacks registered on the loop; arg is the pointer given at registration
+typedef void (*EventFdCallback)(EventLoop* loop, int fd, uint32_t events, void* arg);
+typedef void (*EventKeyCallback)(EventLoop* loop, int key, void* arg);
+typedef void (*EventTimerCallback)(EventLoop* loop, uint64_t expirations, void* arg);
+typedef void (*EventSignalCallback)(EventLoop* loop, int signo, void* arg);
+
+typedef enum {
+    EV_NONE,      // Free slot
+    EV_FD,        // Arbitrary descriptor (sockets, pipes)
+    EV_STDIN,     // Keyboard input, one callback per key
+    EV_TIMER,     // timerfd based periodic timer
+    EV_SIGNAL     // signalfd based signal delivery
+} EventType;
+
+typedef struct {
+    EventType type;
+    int fd;
+    int signo;
+    void* arg;
+    union {
+        EventFdCallback on_fd;
+        EventKeyCallback on_key;
+        EventTimerCallback on_timer;
+        EventSignalCallback on_signal;
+    } cb;
+} EventHandler;
+
+struct EventLoop {
+    int epoll_fd;
+    volatile int running;
+    EventHandler handlers[EVLOOP_MAX_HANDLERS];
+
+    // Terminal state saved while stdin is registered
+    int stdin_flags;
+    int stdin_is_tty;
+    struct termios stdin_saved;
+
+    // Signals blocked for signalfd delivery, restored on destroy
+    sigset_t blocked;
+    sigset_t saved_mask;
+};
+
+int evloop_init(EventLoop* loop);
+void evloop_destroy(EventLoop* loop);
+
+// Each registration returns a handler id (>= 0) or -1 on failure
+int evloop_add_fd(EventLoop* loop, int fd, uint32_t events, EventFdCallback cb, void* arg);
+int evloop_add_stdin(EventLoop* loop, EventKeyCallback cb, void* arg);
+int evloop_add_timer(EventLoop* loop, long interval_ms, EventTimerCallback cb, void* arg);
+int evloop_set_timer(EventLoop* loop, int id, long interval_ms);
+int evloop_add_signal(EventLoop* loop, int signo, EventSignalCallback cb, void* arg);
+void evloop_remove(EventLoop* loop, int id);
+
+// Block in epoll_wait dispatching callbacks until evloop_stop is called
+int evloop_run(EventLoop* loop);
+void evloop_stop(EventLoop* loop);
+
+#endif
@@ -0,0 +1,153 @@
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "history.h"
+
+#define HISTORY_MASK (HISTORY_CAPACITY - 1)
+
+static const char spark_levels[] = " _.-:=+*#@";   // Lowest to highest
+
+static uint64_t monotonic_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+// Seqlock publish: readers that see the same even seq before and after copying got a whole sample
+static void history_publish(History* history, const HistorySample* sample) {
+    uint64_t n = atomic_load_explicit(&history->count, memory_order_relaxed);
+    HistorySlot* slot = &history->slots[n & HISTORY_MASK];
+
+    atomic_store_explicit(&slot->seq, 2 * n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->sample = *sample;
+    atomic_store_explicit(&slot->seq, 2 * n + 2, memory_order_release);
+    atomic_store_explicit(&history->count, n + 1, memory_order_release);
+}
+
+static void* sampler_main(void* arg) {
+    History* history = arg;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (atomic_load(&history->running)) {
+        HistorySample sample;
+        memset(&sample, 0, sizeof(sample));
+        history->probe(&sample, history->probe_arg);
+        sample.time_ms = monotonic_ms();
+
+        unsigned long started = atomic_load_explicit(&history->started, memory_order_relaxed);
+        unsigned long exited = atomic_load_explicit(&history->exited, memory_order_relaxed);
+        sample.values[HIST_STARTS] = (float)(started - history->last_started);
+        sample.values[HIST_EXITS] = (float)(exited - history->last_exited);
+        history->last_started = started;
+        history->last_exited = exited;
+
+        history_publish(history, &sample);
+
+        // Absolute deadlines keep the period fixed no matter how long the probe took
+        next.tv_nsec += history->interval_ms * 1000000L;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR);
+    }
+    return NULL;
+}
+
+int history_start(History* history, long interval_ms, HistoryProbe probe, void* arg) {
+    memset(history, 0, sizeof(*history));
+    history->interval_ms = interval_ms > 0 ? interval_ms : HISTORY_INTERVAL_MS;
+    history->probe = probe;
+    history->probe_arg = arg;
+    atomic_store(&history->running, 1);
+
+    if (pthread_create(&history->sampler, NULL, sampler_main, history) != 0) {
+        atomic_store(&history->running, 0);
+        return -1;
+    }
+    return 0;
+}
+
+void history_stop(History* history) {
+    if (!atomic_exchange(&history->running, 0)) return;
+    pthread_join(history->sampler, NULL);
+}
+
+void history_count_start(History* history) {
+    atomic_fetch_add_explicit(&history->started, 1, memory_order_relaxed);
+}
+
+void history_count_exit(History* history) {
+    atomic_fetch_add_explicit(&history->exited, 1, memory_order_relaxed);
+}
+
+// Copy sample n; fails if the sampler has overwritten (or is overwriting) the slot
+static int history_read(History* history, uint64_t n, HistorySample* out) {
+    HistorySlot* slot = &history->slots[n & HISTORY_MASK];
+
+    uint64_t before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (before != 2 * n + 2) return 0;
+    *out = slot->sample;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->seq, memory_order_relaxed) == before;
+}
+
+long history_snapshot(History* history, long window_ms, HistorySample* out, long max) {
+    uint64_t count = atomic_load_explicit(&history->count, memory_order_acquire);
+    long wanted = window_ms / history->interval_ms;
+    if (wanted < 1) wanted = 1;
+    if (wanted > max) wanted = max;
+    if (wanted > HISTORY_CAPACITY - 1) wanted = HISTORY_CAPACITY - 1;   // Leave the slot being written alone
+    if ((uint64_t)wanted > count) wanted = (long)count;
+
+    // Copy newest to oldest, stopping at the first slot the sampler has already lapped
+    long copied = 0;
+    for (long i = 0; i < wanted; i++) {
+        if (!history_read(history, count - 1 - (uint64_t)i, &out[wanted - 1 - i])) break;
+        copied++;
+    }
+    if (copied < wanted) memmove(out, out + (wanted - copied), (size_t)copied * sizeof(HistorySample));
+    return copied;
+}
+
+void history_stats(const HistorySample* samples, long n, HistoryMetric metric, HistoryStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (n <= 0) return;
+
+    double sum = 0;
+    stats->min = stats->max = samples[0].values[metric];
+    for (long i = 0; i < n; i++) {
+        float v = samples[i].values[metric];
+        if (v < stats->min) stats->min = v;
+        if (v > stats->max) stats->max = v;
+        sum += v;
+    }
+    stats->samples = n;
+    stats->avg = (float)(sum / n);
+    stats->last = samples[n - 1].values[metric];
+}
+
+void history_sparkline(const HistorySample* samples, long n, HistoryMetric metric, float max, char* out, int width) {
+    int top = (int)sizeof(spark_levels) - 2;
+
+    memset(out, ' ', (size_t)width);
+    out[width] = '\0';
+    if (n <= 0 || max <= 0) return;
+
+    // Fewer samples than columns: one column each, right-aligned so the newest is at the edge
+    int columns = n < width ? (int)n : width;
+    for (int c = 0; c < columns; c++) {
+        long from = (long)c * n / columns;
+        long to = (long)(c + 1) * n / columns;
+        double sum = 0;
+        for (long i = from; i < to; i++) sum += samples[i].values[metric];
+
+        float v = (float)(sum / (to - from)) / max;
+        int level = v <= 0 ? 0 : (int)(v * top + 0.999f);
+        if (level > top) level = top;
+        out[width - columns + c] = spark_levels[level];
+    }
+}
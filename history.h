@@ -0,0 +1,79 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define HISTORY_CAPACITY 1024        // Samples kept per ring (power of two)
+#define HISTORY_INTERVAL_MS 250      // Default sampling period
+
+// Quantities recorded in every sample
+typedef enum {
+    HIST_RAM = 0,      // RAM in use, percent
+    HIST_HDD,          // HDD in use, percent
+    HIST_CPU,          // Cores in use, percent
+    HIST_RUN_QUEUE,    // Tasks waiting for or holding a core
+    HIST_STARTS,       // Tasks started since the previous sample
+    HIST_EXITS,        // Tasks closed since the previous sample
+    HIST_METRIC_COUNT
+} HistoryMetric;
+
+typedef struct {
+    uint64_t time_ms;                    // CLOCK_MONOTONIC time of the sample
+    float values[HIST_METRIC_COUNT];
+} HistorySample;
+
+// One slot of the ring; seq is odd while the sampler is writing it
+typedef struct {
+    _Atomic uint64_t seq;
+    HistorySample sample;
+} HistorySlot;
+
+// Fills everything except time_ms, HIST_STARTS and HIST_EXITS
+typedef void (*HistoryProbe)(HistorySample* sample, void* arg);
+
+// Single writer (the sampler thread), any number of lock-free readers
+typedef struct {
+    HistorySlot slots[HISTORY_CAPACITY];
+    _Atomic uint64_t count;      // Samples ever published
+    long interval_ms;
+
+    HistoryProbe probe;
+    void* probe_arg;
+    pthread_t sampler;
+    atomic_int running;
+
+    // Churn counters bumped by the simulator, turned into per-sample deltas
+    atomic_ulong started;
+    atomic_ulong exited;
+    unsigned long last_started;
+    unsigned long last_exited;
+} History;
+
+typedef struct {
+    long samples;     // Samples inside the window
+    float min;
+    float avg;
+    float max;
+    float last;
+} HistoryStats;
+
+// Start sampling every interval_ms on a background thread
+int history_start(History* history, long interval_ms, HistoryProbe probe, void* arg);
+void history_stop(History* history);
+
+void history_count_start(History* history);
+void history_count_exit(History* history);
+
+// Copy the newest samples covering window_ms (at most max) into out, oldest first
+long history_snapshot(History* history, long window_ms, HistorySample* out, long max);
+
+// Min/avg/max of one metric over a copied snapshot
+void history_stats(const HistorySample* samples, long n, HistoryMetric metric, HistoryStats* stats);
+
+// Render one metric as a sparkline of width characters (plus '\0'), averaging
+// samples that share a column; values are scaled against max
+void history_sparkline(const HistorySample* samples, long n, HistoryMetric metric, float max, char* out, int width);
+
+#endif
@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "mines.h"
+
+#define QUEUE_INITIAL_CAP 4096
+
+static uint64_t mines_rand(MineBoard* board) {
+    // splitmix64: each call is independent, so seeds that differ by one still diverge
+    uint64_t z = (board->rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t* row_of(uint64_t* bits, const MineBoard* board, int y) {
+    return bits + (long)y * board->stride;
+}
+
+static inline void set_cell(uint64_t* bits, const MineBoard* board, int x, int y) {
+    bits[(long)y * board->stride + (x >> 6)] |= 1ull << (x & 63);
+}
+
+static inline void clear_cell(uint64_t* bits, const MineBoard* board, int x, int y) {
+    bits[(long)y * board->stride + (x >> 6)] &= ~(1ull << (x & 63));
+}
+
+// Valid cells of word i in a row; only the last word of a row is partial
+static inline uint64_t word_mask(const MineBoard* board, int i) {
+    int bits = board->width - i * 64;
+    return bits >= 64 ? ~0ull : (1ull << bits) - 1;
+}
+
+int mines_init(MineBoard* board, int width, int height, int mines, uint64_t seed) {
+    memset(board, 0, sizeof(*board));
+    if (width < 1 || height < 1 || width > MINES_MAX_SIDE || height > MINES_MAX_SIDE || mines < 0) return -1;
+
+    board->width = width;
+    board->height = height;
+    board->stride = (width + 63) / 64;
+    board->mine_count = mines;
+    board->rng = seed;
+
+    size_t words = (size_t)board->stride * height;
+    board->mines = calloc(words, sizeof(uint64_t));
+    board->revealed = calloc(words, sizeof(uint64_t));
+    board->flagged = calloc(words, sizeof(uint64_t));
+    board->zero = calloc(words, sizeof(uint64_t));
+    int ok = board->mines && board->revealed && board->flagged && board->zero;
+    for (int k = 0; k < 4; k++) {
+        board->count[k] = calloc(words, sizeof(uint64_t));
+        ok = ok && board->count[k];
+    }
+
+    if (!ok) {
+        mines_free(board);
+        return -1;
+    }
+    return 0;
+}
+
+void mines_free(MineBoard* board) {
+    free(board->mines);
+    free(board->revealed);
+    free(board->flagged);
+    free(board->zero);
+    for (int k = 0; k < 4; k++) free(board->count[k]);
+    free(board->queue);
+    memset(board, 0, sizeof(*board));
+}
+
+// Add a one-bit-per-cell plane to the bit-sliced counters s0..s3 (ripple carry, 64 cells at once)
+#define ADD_PLANE(plane) do {               \
+        uint64_t p_ = (plane);              \
+        uint64_t c0_ = s0 & p_; s0 ^= p_;   \
+        uint64_t c1_ = s1 & c0_; s1 ^= c0_; \
+        uint64_t c2_ = s2 & c1_; s2 ^= c1_; \
+        s3 |= c2_;                          \
+    } while (0)
+
+// Neighbour counts for every cell: the eight shifted mine planes are summed word by word
+static void count_neighbours(MineBoard* board) {
+    int stride = board->stride;
+
+    for (int y = 0; y < board->height; y++) {
+        const uint64_t* rows[3] = {
+            y > 0 ? row_of(board->mines, board, y - 1) : NULL,
+            row_of(board->mines, board, y),
+            y + 1 < board->height ? row_of(board->mines, board, y + 1) : NULL
+        };
+        long base = (long)y * stride;
+
+        for (int i = 0; i < stride; i++) {
+            uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+            for (int r = 0; r < 3; r++) {
+                const uint64_t* row = rows[r];
+                if (row == NULL) continue;
+
+                // Bit x of west holds the mine at x - 1, bit x of east the mine at x + 1
+                uint64_t west = (row[i] << 1) | (i > 0 ? row[i - 1] >> 63 : 0);
+                uint64_t east = (row[i] >> 1) | (i + 1 < stride ? row[i + 1] << 63 : 0);
+                ADD_PLANE(west);
+                ADD_PLANE(east);
+                if (r != 1) ADD_PLANE(row[i]);
+            }
+
+            board->count[0][base + i] = s0;
+            board->count[1][base + i] = s1;
+            board->count[2][base + i] = s2;
+            board->count[3][base + i] = s3;
+            board->zero[base + i] = ~(s0 | s1 | s2 | s3) & ~rows[1][i] & word_mask(board, i);
+        }
+    }
+}
+
+void mines_reset(MineBoard* board, int mines, uint64_t seed) {
+    size_t bytes = (size_t)board->stride * board->height * sizeof(uint64_t);
+
+    memset(board->mines, 0, bytes);
+    memset(board->revealed, 0, bytes);
+    memset(board->flagged, 0, bytes);
+    board->mine_count = mines;
+    board->placed = 0;
+    board->safe_left = 0;
+    board->rng = seed;
+}
+
+static int in_safe_zone(int x, int y, int safe_x, int safe_y) {
+    return abs(x - safe_x) <= 1 && abs(y - safe_y) <= 1;
+}
+
+void mines_place(MineBoard* board, int safe_x, int safe_y) {
+    long cells = (long)board->width * board->height;
+    long zone = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int x = safe_x + dx, y = safe_y + dy;
+            if (x >= 0 && x < board->width && y >= 0 && y < board->height) zone++;
+        }
+    }
+
+    long available = cells - zone;
+    long target = board->mine_count < available ? board->mine_count : available;
+    board->mine_count = (int)target;
+
+    if (target <= available / 2) {
+        // Sparse boards: rejection sampling converges quickly
+        for (long placed = 0; placed < target; ) {
+            long cell = (long)(mines_rand(board) % (uint64_t)cells);
+            int x = (int)(cell % board->width), y = (int)(cell / board->width);
+            if (in_safe_zone(x, y, safe_x, safe_y) || mines_bit(board->mines, board, x, y)) continue;
+            set_cell(board->mines, board, x, y);
+            placed++;
+        }
+    }
+    else {
+        // Dense boards: fill everything, then dig out the cells that stay safe
+        for (int y = 0; y < board->height; y++) {
+            uint64_t* row = row_of(board->mines, board, y);
+            for (int i = 0; i < board->stride; i++) row[i] = word_mask(board, i);
+        }
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int x = safe_x + dx, y = safe_y + dy;
+                if (x >= 0 && x < board->width && y >= 0 && y < board->height) clear_cell(board->mines, board, x, y);
+            }
+        }
+        for (long removed = 0; removed < available - target; ) {
+            long cell = (long)(mines_rand(board) % (uint64_t)cells);
+            int x = (int)(cell % board->width), y = (int)(cell / board->width);
+            if (!mines_bit(board->mines, board, x, y)) continue;
+            clear_cell(board->mines, board, x, y);
+            removed++;
+        }
+    }
+
+    count_neighbours(board);
+    board->safe_left = cells - target;
+    board->placed = 1;
+}
+
+static int queue_push(MineBoard* board, uint32_t* head, uint32_t* tail, uint32_t cell) {
+    if (*tail == board->queue_cap) {
+        if (*head > 0) {
+            // Reclaim the consumed prefix before growing
+            memmove(board->queue, board->queue + *head, (size_t)(*tail - *head) * sizeof(uint32_t));
+            *tail -= *head;
+            *head = 0;
+        }
+        if (*tail == board->queue_cap) {
+            uint32_t cap = board->queue_cap ? board->queue_cap * 2 : QUEUE_INITIAL_CAP;
+            uint32_t* grown = realloc(board->queue, (size_t)cap * sizeof(uint32_t));
+            if (grown == NULL) return -1;
+            board->queue = grown;
+            board->queue_cap = cap;
+        }
+    }
+    board->queue[(*tail)++] = cell;
+    return 0;
+}
+
+MinesResult mines_reveal(MineBoard* board, int x, int y, long* revealed_out) {
+    if (revealed_out) *revealed_out = 0;
+    if (x < 0 || x >= board->width || y < 0 || y >= board->height) return MINES_SKIPPED;
+
+    if (!board->placed) mines_place(board, x, y);
+
+    if (mines_bit(board->revealed, board, x, y) || mines_bit(board->flagged, board, x, y)) return MINES_SKIPPED;
+
+    set_cell(board->revealed, board, x, y);
+    if (mines_bit(board->mines, board, x, y)) return MINES_BOOM;
+
+    long opened = 1;
+    board->safe_left--;
+    if (board->on_reveal) board->on_reveal(board->on_reveal_ctx, (uint32_t)y * (uint32_t)board->width + (uint32_t)x);
+
+    if (mines_bit(board->zero, board, x, y)) {
+        // Breadth-first over empty cells; each cell is marked when queued so it is visited once
+        uint32_t head = 0, tail = 0;
+        queue_push(board, &head, &tail, (uint32_t)y * (uint32_t)board->width + (uint32_t)x);
+
+        while (head < tail) {
+            uint32_t cell = board->queue[head++];
+            int cx = (int)(cell % (uint32_t)board->width);
+            int cy = (int)(cell / (uint32_t)board->width);
+
+            for (int ny = cy - 1; ny <= cy + 1; ny++) {
+                if (ny < 0 || ny >= board->height) continue;
+                for (int nx = cx - 1; nx <= cx + 1; nx++) {
+                    if (nx < 0 || nx >= board->width) continue;
+                    if (mines_bit(board->revealed, board, nx, ny) || mines_bit(board->flagged, board, nx, ny)) continue;
+
+                    set_cell(board->revealed, board, nx, ny);
+                    opened++;
+                    board->safe_left--;
+                    if (board->on_reveal) board->on_reveal(board->on_reveal_ctx, (uint32_t)ny * (uint32_t)board->width + (uint32_t)nx);
+
+                    if (mines_bit(board->zero, board, nx, ny) &&
+                        queue_push(board, &head, &tail, (uint32_t)ny * (uint32_t)board->width + (uint32_t)nx) != 0) {
+                        break;   // Out of memory: leave the rest of the region covered
+                    }
+                }
+            }
+        }
+    }
+
+    if (revealed_out) *revealed_out = opened;
+    return MINES_REVEALED;
+}
+
+void mines_toggle_flag(MineBoard* board, int x, int y) {
+    if (x < 0 || x >= board->width || y < 0 || y >= board->height) return;
+    if (mines_bit(board->revealed, board, x, y)) return;
+
+    board->flagged[(long)y * board->stride + (x >> 6)] ^= 1ull << (x & 63);
+}
+
+int mines_neighbours(const MineBoard* board, int x, int y) {
+    return mines_bit(board->count[0], board, x, y) |
+        (mines_bit(board->count[1], board, x, y) << 1) |
+        (mines_bit(board->count[2], board, x, y) << 2) |
+        (mines_bit(board->count[3], board, x, y) << 3);
+}
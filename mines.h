@@ -0,0 +1,61 @@
+#ifndef MINES_H
+#define MINES_H
+
+#include <stdint.h>
+
+#define MINES_MAX_SIDE 8192   // Largest supported board width or height
+
+typedef enum {
+    MINES_REVEALED,   // One or more safe cells were uncovered
+    MINES_BOOM,       // The cell held a mine
+    MINES_SKIPPED     // Already revealed, flagged or off the board
+} MinesResult;
+
+// Minesweeper board stored as bitboards: every per-cell property is one bit in
+// a row-major array of 64-bit words, so whole rows are processed 64 cells at a time.
+typedef struct {
+    int width;
+    int height;
+    int stride;                // 64-bit words per row
+    int mine_count;
+    int placed;                // Mines are laid out on the first reveal
+    long safe_left;            // Safe cells still covered
+
+    uint64_t* mines;
+    uint64_t* revealed;
+    uint64_t* flagged;
+    uint64_t* count[4];        // Bit-sliced neighbour counts: bit k of every cell's count
+    uint64_t* zero;            // Safe cells with no neighbouring mines
+
+    // Flood-fill work queue, grown on demand and reused between reveals
+    uint32_t* queue;
+    uint32_t queue_cap;
+
+    uint64_t rng;
+
+    // Optional observer told about every safe cell a reveal uncovers
+    void (*on_reveal)(void* ctx, uint32_t cell);
+    void* on_reveal_ctx;
+} MineBoard;
+
+int mines_init(MineBoard* board, int width, int height, int mines, uint64_t seed);
+void mines_free(MineBoard* board);
+
+// Clear the board for a new game of the same size, keeping its allocations
+void mines_reset(MineBoard* board, int mines, uint64_t seed);
+
+// Lay out mines keeping the 3x3 block around (safe_x, safe_y) clear, then count neighbours
+void mines_place(MineBoard* board, int safe_x, int safe_y);
+
+// Uncover a cell; empty regions are opened with an iterative flood fill.
+// revealed_out (optional) receives how many cells were uncovered.
+MinesResult mines_reveal(MineBoard* board, int x, int y, long* revealed_out);
+void mines_toggle_flag(MineBoard* board, int x, int y);
+
+int mines_neighbours(const MineBoard* board, int x, int y);
+
+static inline int mines_bit(const uint64_t* bits, const MineBoard* board, int x, int y) {
+    return (int)((bits[(long)y * board->stride + (x >> 6)] >> (x & 63)) & 1);
+}
+
+#endif
@@ -0,0 +1,421 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "minesolver.h"
+
+#define BENCH_CHUNK 64          // Games a worker claims at a time
+#define INTERIOR_PROBES 64      // Random tries to find a guess away from the frontier
+
+typedef struct {
+    uint32_t cells[8];
+    int count;
+} CellSet;
+
+static inline int bit_get(const uint64_t* bits, uint32_t cell) {
+    return (int)((bits[cell >> 6] >> (cell & 63)) & 1);
+}
+
+static inline void bit_set(uint64_t* bits, uint32_t cell) {
+    bits[cell >> 6] |= 1ull << (cell & 63);
+}
+
+static inline void bit_clear(uint64_t* bits, uint32_t cell) {
+    bits[cell >> 6] &= ~(1ull << (cell & 63));
+}
+
+static uint64_t solver_rand(MinesSolver* solver) {
+    uint64_t x = solver->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    solver->rng = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+static int is_covered(const MineBoard* board, int x, int y) {
+    return !mines_bit(board->revealed, board, x, y) && !mines_bit(board->flagged, board, x, y);
+}
+
+// Queue a revealed number so its constraint is re-examined
+static void push_cell(MinesSolver* solver, uint32_t cell) {
+    MineBoard* board = solver->board;
+    int x = (int)(cell % (uint32_t)board->width), y = (int)(cell / (uint32_t)board->width);
+
+    if (!mines_bit(board->revealed, board, x, y) || bit_get(solver->queued, cell)) return;
+    if (mines_neighbours(board, x, y) == 0) return;
+
+    bit_set(solver->queued, cell);
+    solver->stack[solver->stack_len++] = cell;
+}
+
+static void push_neighbours(MinesSolver* solver, int x, int y) {
+    MineBoard* board = solver->board;
+
+    for (int ny = y - 1; ny <= y + 1; ny++) {
+        if (ny < 0 || ny >= board->height) continue;
+        for (int nx = x - 1; nx <= x + 1; nx++) {
+            if (nx < 0 || nx >= board->width) continue;
+            push_cell(solver, (uint32_t)ny * (uint32_t)board->width + (uint32_t)nx);
+        }
+    }
+}
+
+// Every uncovered cell changes the constraints of the numbers around it
+static void on_reveal(void* ctx, uint32_t cell) {
+    MinesSolver* solver = ctx;
+    int width = solver->board->width;
+    push_neighbours(solver, (int)(cell % (uint32_t)width), (int)(cell / (uint32_t)width));
+}
+
+// Covered neighbours of a revealed number and how many of them must still be mines
+static int constraint(const MineBoard* board, int x, int y, CellSet* unknown) {
+    int flags = 0;
+    unknown->count = 0;
+
+    for (int ny = y - 1; ny <= y + 1; ny++) {
+        if (ny < 0 || ny >= board->height) continue;
+        for (int nx = x - 1; nx <= x + 1; nx++) {
+            if (nx < 0 || nx >= board->width || (nx == x && ny == y)) continue;
+            if (mines_bit(board->flagged, board, nx, ny)) {
+                flags++;
+            }
+            else if (!mines_bit(board->revealed, board, nx, ny)) {
+                unknown->cells[unknown->count++] = (uint32_t)ny * (uint32_t)board->width + (uint32_t)nx;
+            }
+        }
+    }
+    return mines_neighbours(board, x, y) - flags;
+}
+
+static void solver_reveal(MinesSolver* solver, uint32_t cell, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    int x = (int)(cell % (uint32_t)board->width), y = (int)(cell / (uint32_t)board->width);
+
+    if (!is_covered(board, x, y)) return;
+    result->reveals++;
+    if (mines_reveal(board, x, y, NULL) == MINES_BOOM) {
+        solver->boom = 1;
+    }
+}
+
+static void solver_flag(MinesSolver* solver, uint32_t cell, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    int x = (int)(cell % (uint32_t)board->width), y = (int)(cell / (uint32_t)board->width);
+
+    if (!is_covered(board, x, y)) return;
+    mines_toggle_flag(board, x, y);
+    result->flags++;
+    push_neighbours(solver, x, y);
+}
+
+// Apply "all safe" / "all mines" to one number; returns 1 if the board changed
+static int examine(MinesSolver* solver, uint32_t cell, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    int x = (int)(cell % (uint32_t)board->width), y = (int)(cell / (uint32_t)board->width);
+    CellSet unknown;
+
+    int need = constraint(board, x, y, &unknown);
+    if (unknown.count == 0) return 0;
+
+    if (need == 0) {
+        for (int i = 0; i < unknown.count && !solver->boom; i++) solver_reveal(solver, unknown.cells[i], result);
+        return 1;
+    }
+    if (need == unknown.count) {
+        for (int i = 0; i < unknown.count; i++) solver_flag(solver, unknown.cells[i], result);
+        return 1;
+    }
+
+    if (!bit_get(solver->in_frontier, cell)) {
+        bit_set(solver->in_frontier, cell);
+        solver->frontier[solver->frontier_len++] = cell;
+    }
+    return 0;
+}
+
+static int set_contains(const CellSet* set, uint32_t cell) {
+    for (int i = 0; i < set->count; i++) {
+        if (set->cells[i] == cell) return 1;
+    }
+    return 0;
+}
+
+// Subset rule: if A's covered cells are a subset of B's, the difference holds need(B) - need(A) mines
+static int subset_pass(MinesSolver* solver, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    long kept = 0;
+
+    for (long i = 0; i < solver->frontier_len; i++) {
+        uint32_t a = solver->frontier[i];
+        int ax = (int)(a % (uint32_t)board->width), ay = (int)(a / (uint32_t)board->width);
+        CellSet ua;
+        int need_a = constraint(board, ax, ay, &ua);
+
+        if (ua.count == 0) {
+            bit_clear(solver->in_frontier, a);
+            continue;
+        }
+        solver->frontier[kept++] = a;
+
+        for (int by = ay - 2; by <= ay + 2; by++) {
+            if (by < 0 || by >= board->height) continue;
+            for (int bx = ax - 2; bx <= ax + 2; bx++) {
+                if (bx < 0 || bx >= board->width || (bx == ax && by == ay)) continue;
+                if (!mines_bit(board->revealed, board, bx, by) || mines_neighbours(board, bx, by) == 0) continue;
+
+                CellSet ub;
+                int need_b = constraint(board, bx, by, &ub);
+                if (ub.count <= ua.count) continue;
+
+                int subset = 1;
+                for (int k = 0; k < ua.count && subset; k++) subset = set_contains(&ub, ua.cells[k]);
+                if (!subset) continue;
+
+                int diff_mines = need_b - need_a;
+                int diff_count = ub.count - ua.count;
+                if (diff_mines != 0 && diff_mines != diff_count) continue;
+
+                for (int k = 0; k < ub.count; k++) {
+                    if (set_contains(&ua, ub.cells[k])) continue;
+                    if (diff_mines == 0) {
+                        if (!solver->boom) solver_reveal(solver, ub.cells[k], result);
+                    }
+                    else {
+                        solver_flag(solver, ub.cells[k], result);
+                    }
+                }
+
+                // Keep the rest of the frontier for the next pass
+                for (long j = i + 1; j < solver->frontier_len; j++) solver->frontier[kept++] = solver->frontier[j];
+                solver->frontier_len = kept;
+                return 1;
+            }
+        }
+    }
+
+    solver->frontier_len = kept;
+    return 0;
+}
+
+// Mine probability of a covered frontier cell: the most pessimistic of its constraints
+static double cell_risk(const MineBoard* board, int x, int y) {
+    double risk = 0.0;
+
+    for (int ny = y - 1; ny <= y + 1; ny++) {
+        if (ny < 0 || ny >= board->height) continue;
+        for (int nx = x - 1; nx <= x + 1; nx++) {
+            if (nx < 0 || nx >= board->width || !mines_bit(board->revealed, board, nx, ny)) continue;
+
+            CellSet unknown;
+            int need = constraint(board, nx, ny, &unknown);
+            if (unknown.count > 0 && (double)need / unknown.count > risk) risk = (double)need / unknown.count;
+        }
+    }
+    return risk;
+}
+
+static int touches_revealed(const MineBoard* board, int x, int y) {
+    for (int ny = y - 1; ny <= y + 1; ny++) {
+        if (ny < 0 || ny >= board->height) continue;
+        for (int nx = x - 1; nx <= x + 1; nx++) {
+            if (nx >= 0 && nx < board->width && mines_bit(board->revealed, board, nx, ny)) return 1;
+        }
+    }
+    return 0;
+}
+
+// No certain move left: open the covered cell least likely to be a mine
+static void guess(MinesSolver* solver, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    long cells = (long)board->width * board->height;
+    long covered = board->safe_left + board->mine_count - result->flags;
+    double density = covered > 0 ? (double)(board->mine_count - result->flags) / covered : 1.0;
+
+    long best = -1;
+    double best_risk = 2.0;
+    for (long i = 0; i < solver->frontier_len; i++) {
+        uint32_t cell = solver->frontier[i];
+        int x = (int)(cell % (uint32_t)board->width), y = (int)(cell / (uint32_t)board->width);
+        CellSet unknown;
+        constraint(board, x, y, &unknown);
+
+        for (int k = 0; k < unknown.count; k++) {
+            int ux = (int)(unknown.cells[k] % (uint32_t)board->width);
+            int uy = (int)(unknown.cells[k] / (uint32_t)board->width);
+            double risk = cell_risk(board, ux, uy);
+            if (risk < best_risk) {
+                best_risk = risk;
+                best = unknown.cells[k];
+            }
+        }
+    }
+
+    // A cell away from every number carries roughly the board's leftover mine density
+    if (best < 0 || density < best_risk) {
+        long interior = -1;
+        for (int i = 0; i < INTERIOR_PROBES && interior < 0; i++) {
+            long cell = (long)(solver_rand(solver) % (uint64_t)cells);
+            int x = (int)(cell % board->width), y = (int)(cell / board->width);
+            if (is_covered(board, x, y) && !touches_revealed(board, x, y)) interior = cell;
+        }
+        for (long cell = 0; cell < cells && interior < 0; cell++) {
+            int x = (int)(cell % board->width), y = (int)(cell / board->width);
+            if (is_covered(board, x, y) && (best < 0 || !touches_revealed(board, x, y))) interior = cell;
+        }
+        if (interior >= 0) best = interior;
+    }
+
+    if (best >= 0) {
+        result->guesses++;
+        solver_reveal(solver, (uint32_t)best, result);
+    }
+}
+
+int mines_solver_init(MinesSolver* solver, MineBoard* board) {
+    long cells = (long)board->width * board->height;
+    size_t words = (size_t)(cells + 63) / 64;
+
+    memset(solver, 0, sizeof(*solver));
+    solver->board = board;
+    solver->stack = malloc((size_t)cells * sizeof(uint32_t));
+    solver->frontier = malloc((size_t)cells * sizeof(uint32_t));
+    solver->queued = calloc(words, sizeof(uint64_t));
+    solver->in_frontier = calloc(words, sizeof(uint64_t));
+    solver->rng = board->rng | 1;
+
+    if (!solver->stack || !solver->frontier || !solver->queued || !solver->in_frontier) {
+        mines_solver_free(solver);
+        return -1;
+    }
+    return 0;
+}
+
+void mines_solver_free(MinesSolver* solver) {
+    free(solver->stack);
+    free(solver->frontier);
+    free(solver->queued);
+    free(solver->in_frontier);
+    memset(solver, 0, sizeof(*solver));
+}
+
+void mines_solve(MinesSolver* solver, MinesSolveResult* result) {
+    MineBoard* board = solver->board;
+    long cells = (long)board->width * board->height;
+    size_t words = (size_t)(cells + 63) / 64;
+
+    memset(result, 0, sizeof(*result));
+    memset(solver->queued, 0, words * sizeof(uint64_t));
+    memset(solver->in_frontier, 0, words * sizeof(uint64_t));
+    solver->stack_len = 0;
+    solver->frontier_len = 0;
+    solver->boom = 0;
+    solver->rng ^= board->rng;
+    if (solver->rng == 0) solver->rng = 1;
+
+    board->on_reveal = on_reveal;
+    board->on_reveal_ctx = solver;
+
+    solver_reveal(solver, (uint32_t)(board->height / 2) * (uint32_t)board->width + (uint32_t)(board->width / 2), result);
+
+    while (!solver->boom && board->safe_left > 0) {
+        if (solver->stack_len > 0) {
+            uint32_t cell = solver->stack[--solver->stack_len];
+            bit_clear(solver->queued, cell);
+            examine(solver, cell, result);
+        }
+        else if (!subset_pass(solver, result)) {
+            guess(solver, result);
+        }
+    }
+
+    board->on_reveal = NULL;
+    result->won = !solver->boom;
+}
+
+typedef struct {
+    const MinesBenchConfig* config;
+    atomic_long next_game;
+    atomic_long wins;
+    atomic_long guesses;
+    atomic_long played;
+} BenchShared;
+
+static void* bench_worker(void* arg) {
+    BenchShared* shared = arg;
+    const MinesBenchConfig* config = shared->config;
+    MineBoard board;
+    MinesSolver solver;
+    long wins = 0, guesses = 0, played = 0;
+
+    if (mines_init(&board, config->width, config->height, config->mines, config->seed) != 0) return NULL;
+    if (mines_solver_init(&solver, &board) != 0) {
+        mines_free(&board);
+        return NULL;
+    }
+
+    // Claim games in chunks so workers rarely touch the shared counter
+    for (;;) {
+        long first = atomic_fetch_add_explicit(&shared->next_game, BENCH_CHUNK, memory_order_relaxed);
+        if (first >= config->games) break;
+        long last = first + BENCH_CHUNK < config->games ? first + BENCH_CHUNK : config->games;
+
+        for (long game = first; game < last; game++) {
+            MinesSolveResult result;
+            mines_reset(&board, config->mines, config->seed + (uint64_t)game);
+            mines_solve(&solver, &result);
+            wins += result.won;
+            guesses += result.guesses;
+            played++;
+        }
+    }
+
+    atomic_fetch_add(&shared->wins, wins);
+    atomic_fetch_add(&shared->guesses, guesses);
+    atomic_fetch_add(&shared->played, played);
+
+    mines_solver_free(&solver);
+    mines_free(&board);
+    return NULL;
+}
+
+int mines_benchmark(const MinesBenchConfig* config, MinesBenchResult* result) {
+    int threads = config->threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0) threads = 1;
+
+    pthread_t* workers = malloc((size_t)threads * sizeof(pthread_t));
+    if (workers == NULL) return -1;
+
+    BenchShared shared;
+    shared.config = config;
+    atomic_init(&shared.next_game, 0);
+    atomic_init(&shared.wins, 0);
+    atomic_init(&shared.guesses, 0);
+    atomic_init(&shared.played, 0);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&workers[i], NULL, bench_worker, &shared) == 0) started++;
+        else break;
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(workers);
+
+    result->games = atomic_load(&shared.played);
+    result->wins = atomic_load(&shared.wins);
+    result->guesses = atomic_load(&shared.guesses);
+    result->threads = started;
+    result->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    return started > 0 && result->games == config->games ? 0 : -1;
+}
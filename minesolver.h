@@ -0,0 +1,55 @@
+#ifndef MINESOLVER_H
+#define MINESOLVER_H
+
+#include <stdint.h>
+
+#include "mines.h"
+
+// Outcome of one automatically played game
+typedef struct {
+    int won;
+    long reveals;   // Cells the solver chose to uncover
+    long guesses;   // Reveals made without a certain deduction
+    long flags;     // Mines the solver marked
+} MinesSolveResult;
+
+// Solver scratch space, sized for one board and reused across games on it
+typedef struct {
+    MineBoard* board;
+    uint32_t* stack;          // Revealed numbers whose constraint may have changed
+    long stack_len;
+    uint64_t* queued;         // Bitmap: cell already on the stack
+    uint32_t* frontier;       // Numbers that still border covered cells
+    long frontier_len;
+    uint64_t* in_frontier;    // Bitmap: cell already in the frontier list
+    uint64_t rng;
+    int boom;
+} MinesSolver;
+
+int mines_solver_init(MinesSolver* solver, MineBoard* board);
+void mines_solver_free(MinesSolver* solver);
+
+// Play the board (reset, mines not yet placed) from the centre until it is won or lost
+void mines_solve(MinesSolver* solver, MinesSolveResult* result);
+
+typedef struct {
+    long games;       // Games to play
+    int threads;      // Worker threads, 0 for one per online CPU
+    int width;
+    int height;
+    int mines;
+    uint64_t seed;    // Game i is played with seed + i, so runs are reproducible
+} MinesBenchConfig;
+
+typedef struct {
+    long games;
+    long wins;
+    long guesses;
+    int threads;
+    double seconds;
+} MinesBenchResult;
+
+// Play many seeded games in parallel across threads
+int mines_benchmark(const MinesBenchConfig* config, MinesBenchResult* result);
+
+#endif
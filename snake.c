@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "snake.h"
+
+#define FOOD_RANDOM_TRIES 64
+
+static uint64_t snake_rand(SnakeGame* game) {
+    // xorshift64*: cheap and good enough for picking food cells
+    uint64_t x = game->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    game->rng = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+static inline void set_bit(uint64_t* bits, int cell) {
+    bits[cell >> 6] |= 1ull << (cell & 63);
+}
+
+static inline void clear_bit(uint64_t* bits, int cell) {
+    bits[cell >> 6] &= ~(1ull << (cell & 63));
+}
+
+static inline int test_bit(const uint64_t* bits, int cell) {
+    return (int)((bits[cell >> 6] >> (cell & 63)) & 1);
+}
+
+// Pick a free cell: random probes first, then a word-at-a-time scan of the bitmap
+static int place_food(SnakeGame* game) {
+    if (game->length >= game->capacity) return -1;
+
+    for (int i = 0; i < FOOD_RANDOM_TRIES; i++) {
+        int cell = (int)(snake_rand(game) % (uint64_t)game->capacity);
+        if (!test_bit(game->occupied, cell)) return cell;
+    }
+
+    int words = (game->capacity + 63) / 64;
+    int start = (int)(snake_rand(game) % (uint64_t)words);
+    for (int i = 0; i < words; i++) {
+        int w = (start + i) % words;
+        uint64_t free_bits = ~game->occupied[w];
+        if (free_bits) {
+            // Bits past the end of the board are never set, so only the lowest one can be valid
+            int cell = w * 64 + __builtin_ctzll(free_bits);
+            if (cell < game->capacity) return cell;
+        }
+    }
+    return -1;
+}
+
+int snake_init(SnakeGame* game, int width, int height, uint64_t seed) {
+    memset(game, 0, sizeof(*game));
+    if (width < 2 || height < 1 || width > SNAKE_MAX_SIDE || height > SNAKE_MAX_SIDE) return -1;
+
+    game->width = width;
+    game->height = height;
+    game->capacity = width * height;
+    game->body = malloc((size_t)game->capacity * sizeof(int));
+    game->occupied = calloc((size_t)(game->capacity + 63) / 64, sizeof(uint64_t));
+    if (game->body == NULL || game->occupied == NULL) {
+        snake_free(game);
+        return -1;
+    }
+
+    game->rng = seed ? seed : 0x9E3779B97F4A7C15ull;
+
+    int start = (height / 2) * width + width / 2;
+    game->head = 0;
+    game->body[0] = start;
+    game->length = 1;
+    set_bit(game->occupied, start);
+
+    game->direction = game->pending = SNAKE_RIGHT;
+    game->food = place_food(game);
+    game->vacated = -1;
+    game->old_food = -1;
+    return 0;
+}
+
+void snake_free(SnakeGame* game) {
+    free(game->body);
+    free(game->occupied);
+    game->body = NULL;
+    game->occupied = NULL;
+}
+
+void snake_turn(SnakeGame* game, SnakeDirection direction) {
+    // Opposite directions differ by two in the enum
+    if (((direction - game->direction) & 3) == 2) return;
+    game->pending = direction;
+}
+
+SnakeResult snake_step(SnakeGame* game) {
+    int cell = game->body[game->head];
+    int x = cell % game->width;
+    int y = cell / game->width;
+
+    game->direction = game->pending;
+    switch (game->direction) {
+    case SNAKE_UP:    y--; break;
+    case SNAKE_LEFT:  x--; break;
+    case SNAKE_DOWN:  y++; break;
+    case SNAKE_RIGHT: x++; break;
+    }
+
+    game->vacated = -1;
+    game->old_food = -1;
+
+    if (x < 0 || x >= game->width || y < 0 || y >= game->height) {
+        return SNAKE_CRASHED;
+    }
+    int next = y * game->width + x;
+
+    // Free the tail first: moving into the cell it is leaving is legal
+    if (game->grow > 0) {
+        game->grow--;
+    }
+    else {
+        int tail_slot = game->head - game->length + 1;
+        if (tail_slot < 0) tail_slot += game->capacity;
+        game->vacated = game->body[tail_slot];
+        clear_bit(game->occupied, game->vacated);
+        game->length--;
+    }
+
+    if (test_bit(game->occupied, next)) {
+        return SNAKE_CRASHED;
+    }
+
+    set_bit(game->occupied, next);
+    game->head = game->head + 1 == game->capacity ? 0 : game->head + 1;
+    game->body[game->head] = next;
+    game->length++;
+
+    if (next != game->food) {
+        return SNAKE_MOVED;
+    }
+
+    game->score++;
+    game->grow++;
+    game->old_food = next;
+    game->food = place_food(game);
+    if (game->food < 0 && game->length + game->grow >= game->capacity) {
+        return SNAKE_WON;
+    }
+    return SNAKE_ATE;
+}
+
+int snake_head(const SnakeGame* game) {
+    return game->body[game->head];
+}
+
+int snake_is_occupied(const SnakeGame* game, int cell) {
+    return test_bit(game->occupied, cell);
+}
@@ -0,0 +1,55 @@
+#ifndef SNAKE_H
+#define SNAKE_H
+
+#include <stdint.h>
+
+#define SNAKE_MAX_SIDE 4096   // Largest supported board width or height
+
+typedef enum {
+    SNAKE_UP,
+    SNAKE_LEFT,
+    SNAKE_DOWN,
+    SNAKE_RIGHT
+} SnakeDirection;
+
+typedef enum {
+    SNAKE_MOVED,     // Head advanced into an empty cell
+    SNAKE_ATE,       // Head reached the food
+    SNAKE_CRASHED,   // Head hit a wall or the body
+    SNAKE_WON        // Body fills the whole board
+} SnakeResult;
+
+// Snake engine: the body is a ring buffer of cell indices and an occupancy
+// bitmap answers "is this cell taken" in O(1), so a step never touches the
+// rest of the body no matter how long it gets.
+typedef struct {
+    int width;                  // Playfield width (walls excluded)
+    int height;                 // Playfield height (walls excluded)
+    int capacity;               // width * height, the longest possible body
+    int* body;                  // Ring buffer of cell indices
+    int head;                   // Ring slot holding the head
+    int length;                 // Segments currently on the board
+    int grow;                   // Segments still to add after eating
+    uint64_t* occupied;         // One bit per cell
+    int food;                   // Cell index of the food, -1 when the board is full
+    SnakeDirection direction;   // Direction used by the last step
+    SnakeDirection pending;     // Direction the next step will use
+    int score;
+    uint64_t rng;               // Food placement PRNG state
+
+    // Cells changed by the last step so a renderer can redraw just those
+    int vacated;                // Old tail cell, -1 if the snake grew
+    int old_food;               // Food cell eaten, -1 if none
+} SnakeGame;
+
+int snake_init(SnakeGame* game, int width, int height, uint64_t seed);
+void snake_free(SnakeGame* game);
+
+// Queue a turn for the next step; reversing onto the body is ignored
+void snake_turn(SnakeGame* game, SnakeDirection direction);
+SnakeResult snake_step(SnakeGame* game);
+
+int snake_head(const SnakeGame* game);
+int snake_is_occupied(const SnakeGame* game, int cell);
+
+#endif
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+
+#include "synth.h"
+
+#define WAV_HEADER_BYTES 44
+#define WAV_STREAMING_SIZE 0xFFFFFFFFu   // Size used when the header cannot be patched later
+
+const SynthEnvelope synth_default_envelope = { 10, 60, 0.7f, 80 };
+
+static void put_le16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// 16-bit mono PCM header; data_bytes is patched in later for seekable outputs
+static void wav_header(uint8_t* h, uint32_t data_bytes) {
+    uint32_t riff_size = data_bytes == WAV_STREAMING_SIZE ? WAV_STREAMING_SIZE : data_bytes + 36;
+
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, riff_size);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le32(h + 16, 16);                        // fmt chunk size
+    put_le16(h + 20, 1);                         // PCM
+    put_le16(h + 22, 1);                         // Mono
+    put_le32(h + 24, SYNTH_SAMPLE_RATE);
+    put_le32(h + 28, SYNTH_SAMPLE_RATE * 2);     // Byte rate
+    put_le16(h + 32, 2);                         // Block align
+    put_le16(h + 34, 16);                        // Bits per sample
+    memcpy(h + 36, "data", 4);
+    put_le32(h + 40, data_bytes);
+}
+
+static int write_all(int fd, const void* buf, size_t len) {
+    const char* p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static void pause_briefly() {
+    struct timespec ts = { 0, 200000 };
+    nanosleep(&ts, NULL);
+}
+
+// Consumer side: move whatever the producer published to the file descriptor
+static void* writer_main(void* arg) {
+    SynthOutput* out = arg;
+    PcmRing* ring = &out->ring;
+    size_t capacity = ring->mask + 1;
+
+    for (;;) {
+        int closing = atomic_load_explicit(&out->closing, memory_order_acquire);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+        if (head == tail) {
+            if (closing) break;
+            pause_briefly();
+            continue;
+        }
+
+        // Write up to the end of the ring; the wrapped part goes out next round
+        size_t chunk = head - tail;
+        size_t until_wrap = capacity - (tail & ring->mask);
+        if (chunk > until_wrap) chunk = until_wrap;
+
+        if (!atomic_load_explicit(&out->failed, memory_order_relaxed) &&
+            write_all(out->fd, ring->samples + (tail & ring->mask), chunk * sizeof(int16_t)) != 0) {
+            atomic_store(&out->failed, 1);
+        }
+        out->samples_written += chunk;
+        atomic_store_explicit(&ring->tail, tail + chunk, memory_order_release);
+    }
+    return NULL;
+}
+
+// Producer side: block (politely) while the ring is full
+static void ring_push(SynthOutput* out, const int16_t* samples, size_t n) {
+    PcmRing* ring = &out->ring;
+    size_t capacity = ring->mask + 1;
+
+    while (n > 0) {
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        size_t space = capacity - (head - tail);
+
+        if (space == 0) {
+            sched_yield();
+            continue;
+        }
+
+        size_t chunk = n < space ? n : space;
+        size_t until_wrap = capacity - (head & ring->mask);
+        if (chunk > until_wrap) chunk = until_wrap;
+
+        memcpy(ring->samples + (head & ring->mask), samples, chunk * sizeof(int16_t));
+        atomic_store_explicit(&ring->head, head + chunk, memory_order_release);
+        samples += chunk;
+        n -= chunk;
+    }
+}
+
+int synth_open(SynthOutput* out, const char* path) {
+    memset(out, 0, sizeof(*out));
+
+    if (strcmp(path, "-") == 0) {
+        out->fd = STDOUT_FILENO;
+        fflush(stdout);
+    }
+    else {
+        out->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (out->fd == -1) return -1;
+        out->owns_fd = 1;
+    }
+
+    // Pipes get a streaming header; files get real sizes patched in on close
+    out->seekable = lseek(out->fd, 0, SEEK_CUR) == 0;
+
+    uint8_t header[WAV_HEADER_BYTES];
+    wav_header(header, out->seekable ? 0 : WAV_STREAMING_SIZE);
+    if (write_all(out->fd, header, sizeof(header)) != 0) {
+        if (out->owns_fd) close(out->fd);
+        return -1;
+    }
+
+    out->ring.samples = malloc(SYNTH_RING_SAMPLES * sizeof(int16_t));
+    if (out->ring.samples == NULL) {
+        if (out->owns_fd) close(out->fd);
+        return -1;
+    }
+    out->ring.mask = SYNTH_RING_SAMPLES - 1;
+    atomic_init(&out->ring.head, 0);
+    atomic_init(&out->ring.tail, 0);
+    atomic_init(&out->closing, 0);
+    atomic_init(&out->failed, 0);
+
+    if (pthread_create(&out->writer, NULL, writer_main, out) != 0) {
+        free(out->ring.samples);
+        if (out->owns_fd) close(out->fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Render samples [start, start + n) of a note. Every loop is branch-free
+// element-wise float math so the compiler can vectorize it.
+static void render_block(float* buffer, int n, long start, long total, const SynthNote* note, const SynthEnvelope* env) {
+    if (note->frequency <= 0.0 || note->amplitude <= 0.0f) {
+        memset(buffer, 0, (size_t)n * sizeof(float));
+        return;
+    }
+
+    // Phase in cycles: the block's base in double precision, per-sample offsets in float
+    double increment = note->frequency / SYNTH_SAMPLE_RATE;
+    double base = (double)start * increment;
+    base -= (double)(long)base;
+    float inc = (float)increment;
+    float phase0 = (float)base;
+
+    float attack = env->attack_ms * (SYNTH_SAMPLE_RATE / 1000.0f) + 1.0f;
+    float decay = env->decay_ms * (SYNTH_SAMPLE_RATE / 1000.0f) + 1.0f;
+    float release = env->release_ms * (SYNTH_SAMPLE_RATE / 1000.0f) + 1.0f;
+    float sustain = env->sustain;
+    float amplitude = note->amplitude;
+    float first = (float)start;
+    float last = (float)total;
+
+    for (int i = 0; i < n; i++) {
+        // Oscillator: wrap phase to [0, 1) and approximate sin(2*pi*phase) with a refined parabola
+        float p = phase0 + (float)i * inc;
+        p -= (float)(int)p;
+        float x = 2.0f * p - 1.0f;
+        float y = 4.0f * x * (1.0f - __builtin_fabsf(x));
+        y = 0.225f * (y * __builtin_fabsf(y) - y) + y;
+
+        // Envelope: attack ramp, decay to sustain, then release ramp at the note's end
+        float k = first + (float)i;
+        float rise = k / attack;
+        float fall = 1.0f - (1.0f - sustain) * (k - attack) / decay;
+        float held = fall > sustain ? fall : sustain;
+        float level = rise < held ? rise : held;
+        float tail = (last - k) / release;
+        level *= tail < 1.0f ? tail : 1.0f;
+
+        buffer[i] = -y * level * amplitude;
+    }
+}
+
+void synth_render_note(float* buffer, long n, const SynthNote* note, const SynthEnvelope* env) {
+    for (long done = 0; done < n; done += SYNTH_BLOCK) {
+        int block = n - done < SYNTH_BLOCK ? (int)(n - done) : SYNTH_BLOCK;
+        render_block(buffer + done, block, done, n, note, env);
+    }
+}
+
+static void to_pcm16(int16_t* out, const float* in, int n) {
+    for (int i = 0; i < n; i++) {
+        float v = in[i] * 32767.0f;
+        v = v > 32767.0f ? 32767.0f : v;
+        v = v < -32768.0f ? -32768.0f : v;
+        out[i] = (int16_t)v;
+    }
+}
+
+long synth_play(SynthOutput* out, const SynthNote* notes, int count, const SynthEnvelope* env) {
+    float block[SYNTH_BLOCK];
+    int16_t pcm[SYNTH_BLOCK];
+    long produced = 0;
+
+    if (env == NULL) env = &synth_default_envelope;
+
+    for (int i = 0; i < count && !atomic_load_explicit(&out->failed, memory_order_relaxed); i++) {
+        long n = (long)notes[i].duration_ms * SYNTH_SAMPLE_RATE / 1000;
+
+        for (long done = 0; done < n; done += SYNTH_BLOCK) {
+            int len = n - done < SYNTH_BLOCK ? (int)(n - done) : SYNTH_BLOCK;
+            render_block(block, len, done, n, &notes[i], env);
+            to_pcm16(pcm, block, len);
+            ring_push(out, pcm, (size_t)len);
+        }
+        produced += n;
+    }
+    return produced;
+}
+
+int synth_close(SynthOutput* out) {
+    atomic_store_explicit(&out->closing, 1, memory_order_release);
+    pthread_join(out->writer, NULL);
+    free(out->ring.samples);
+    out->ring.samples = NULL;
+
+    int failed = atomic_load(&out->failed);
+    if (!failed && out->seekable) {
+        uint64_t bytes = out->samples_written * sizeof(int16_t);
+        uint32_t data_bytes = bytes > 0xFFFFFFF0ull ? 0xFFFFFFF0u : (uint32_t)bytes;
+        uint8_t header[WAV_HEADER_BYTES];
+
+        wav_header(header, data_bytes);
+        if (pwrite(out->fd, header, sizeof(header), 0) != (ssize_t)sizeof(header)) failed = 1;
+    }
+
+    if (out->owns_fd && close(out->fd) != 0) failed = 1;
+    return failed ? -1 : 0;
+}
+
+int synth_benchmark(double audio_seconds, SynthBenchResult* result) {
+    // A C major scale, repeated until the requested amount of audio is reached
+    static const double scale[] = { 261.63, 293.66, 329.63, 349.23, 392.00, 440.00, 493.88, 523.25 };
+    int count = (int)(audio_seconds * 1000.0 / 250.0);
+    if (count < 1) count = 1;
+
+    SynthNote* notes = malloc((size_t)count * sizeof(SynthNote));
+    if (notes == NULL) return -1;
+    for (int i = 0; i < count; i++) {
+        notes[i].frequency = scale[i % 8];
+        notes[i].duration_ms = 250;
+        notes[i].amplitude = 0.8f;
+    }
+
+    SynthOutput out;
+    if (synth_open(&out, "/dev/null") != 0) {
+        free(notes);
+        return -1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long samples = synth_play(&out, notes, count, NULL);
+    int rc = synth_close(&out);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(notes);
+
+    result->samples = samples;
+    result->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    result->samples_per_sec = result->seconds > 0 ? samples / result->seconds : 0.0;
+    result->realtime_factor = result->samples_per_sec / SYNTH_SAMPLE_RATE;
+    return rc;
+}
@@ -0,0 +1,70 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define SYNTH_SAMPLE_RATE 44100
+#define SYNTH_BLOCK 256              // Samples rendered per oscillator pass
+#define SYNTH_RING_SAMPLES (1 << 16) // Capacity of the PCM ring (power of two)
+
+// One note of a melody; frequency 0 is a rest
+typedef struct {
+    double frequency;   // Hz
+    int duration_ms;
+    float amplitude;    // 0..1
+} SynthNote;
+
+// Linear ADSR envelope applied to every note
+typedef struct {
+    int attack_ms;
+    int decay_ms;
+    float sustain;      // Level held between decay and release, 0..1
+    int release_ms;
+} SynthEnvelope;
+
+// Single-producer/single-consumer ring of 16-bit samples
+typedef struct {
+    int16_t* samples;
+    size_t mask;
+    _Atomic size_t head;   // Next slot the producer writes
+    _Atomic size_t tail;   // Next slot the consumer reads
+} PcmRing;
+
+// A WAV stream fed through the ring by a writer thread
+typedef struct {
+    int fd;
+    int seekable;              // Header sizes can be patched on close
+    int owns_fd;
+    PcmRing ring;
+    pthread_t writer;
+    atomic_int closing;
+    atomic_int failed;
+    uint64_t samples_written;
+} SynthOutput;
+
+// Open a WAV output; path "-" streams to stdout
+int synth_open(SynthOutput* out, const char* path);
+// Render notes into the output; returns the number of samples produced
+long synth_play(SynthOutput* out, const SynthNote* notes, int count, const SynthEnvelope* env);
+// Drain the ring, finish the WAV header and close; 0 on success
+int synth_close(SynthOutput* out);
+
+// Render one note into a float buffer (no I/O); n must be the note's sample count
+void synth_render_note(float* buffer, long n, const SynthNote* note, const SynthEnvelope* env);
+
+typedef struct {
+    long samples;           // Samples rendered and written
+    double seconds;         // Wall-clock time taken
+    double samples_per_sec;
+    double realtime_factor; // Audio seconds produced per wall-clock second
+} SynthBenchResult;
+
+// Render audio_seconds of music through the ring into /dev/null
+int synth_benchmark(double audio_seconds, SynthBenchResult* result);
+
+extern const SynthEnvelope synth_default_envelope;
+
+#endif
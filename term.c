@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/ioctl.h>
+
+#include "term.h"
+
+#define TERM_DEFAULT_WIDTH  80
+#define TERM_DEFAULT_HEIGHT 24
+
+// Escape sequences for each TermColor, indexed by the enum value
+static const char* term_color_codes[TERM_COLOR_COUNT] = {
+    "\033[0m", "\033[36m", "\033[33m", "\033[35m", "\033[32m", "\033[31m"
+};
+
+// Renderer state: one frame is on screen (front), the next one is being drawn (back)
+static TermCell* front = NULL;
+static TermCell* back = NULL;
+static int frame_width = 0;
+static int frame_height = 0;
+static int full_redraw = 1;
+
+// Output buffer reused across frames so a present is a single write()
+static char* out_buf = NULL;
+static size_t out_cap = 0;
+static size_t out_len = 0;
+
+static TermStats stats;
+static uint64_t last_frame_ns = 0;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void out_reserve(size_t extra) {
+    if (out_len + extra <= out_cap) return;
+
+    size_t cap = out_cap ? out_cap : 4096;
+    while (cap < out_len + extra) cap *= 2;
+    char* grown = realloc(out_buf, cap);
+    if (grown == NULL) {
+        perror("Failed to grow frame buffer");
+        exit(EXIT_FAILURE);
+    }
+    out_buf = grown;
+    out_cap = cap;
+}
+
+static void out_str(const char* s) {
+    size_t n = strlen(s);
+    out_reserve(n);
+    memcpy(out_buf + out_len, s, n);
+    out_len += n;
+}
+
+static void out_uint(unsigned int v) {
+    char digits[12];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    out_reserve(n);
+    while (n) out_buf[out_len++] = digits[--n];
+}
+
+// Move the cursor to a zero-based cell
+static void out_goto(int x, int y) {
+    out_reserve(2);
+    out_buf[out_len++] = '\033';
+    out_buf[out_len++] = '[';
+    out_uint((unsigned int)y + 1);
+    out_reserve(1);
+    out_buf[out_len++] = ';';
+    out_uint((unsigned int)x + 1);
+    out_reserve(1);
+    out_buf[out_len++] = 'H';
+}
+
+static int write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int term_init(int width, int height) {
+    struct winsize ws;
+    int term_w = TERM_DEFAULT_WIDTH, term_h = TERM_DEFAULT_HEIGHT;
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        term_w = ws.ws_col;
+        term_h = ws.ws_row;
+    }
+
+    // Leave the last row free so the parked cursor never scrolls the frame
+    if (width <= 0 || width > term_w) width = term_w;
+    if (height <= 0 || height > term_h - 1) height = term_h - 1;
+    if (height < 1) height = 1;
+
+    term_shutdown();
+
+    front = calloc((size_t)width * height, sizeof(TermCell));
+    back = calloc((size_t)width * height, sizeof(TermCell));
+    if (front == NULL || back == NULL) {
+        free(front);
+        free(back);
+        front = back = NULL;
+        return -1;
+    }
+
+    frame_width = width;
+    frame_height = height;
+    memset(&stats, 0, sizeof(stats));
+    last_frame_ns = 0;
+
+    term_clear();
+    term_invalidate();
+
+    // Hide the cursor while frames are being drawn
+    fflush(stdout);
+    write_all(STDOUT_FILENO, "\033[?25l", 6);
+    return 0;
+}
+
+void term_shutdown() {
+    if (front == NULL) return;
+
+    free(front);
+    free(back);
+    front = back = NULL;
+
+    // Park the cursor below the frame and show it again
+    out_len = 0;
+    out_goto(0, frame_height);
+    out_str(term_color_codes[TERM_DEFAULT]);
+    out_str("\033[?25h");
+    write_all(STDOUT_FILENO, out_buf, out_len);
+    free(out_buf);
+    out_buf = NULL;
+    out_cap = out_len = 0;
+
+    frame_width = frame_height = 0;
+}
+
+int term_width() {
+    return frame_width;
+}
+
+int term_height() {
+    return frame_height;
+}
+
+void term_clear() {
+    if (back == NULL) return;
+
+    for (int i = 0; i < frame_width * frame_height; i++) {
+        back[i].ch = ' ';
+        back[i].color = TERM_DEFAULT;
+    }
+}
+
+void term_put(int x, int y, char ch, TermColor color) {
+    if (back == NULL || x < 0 || y < 0 || x >= frame_width || y >= frame_height) return;
+
+    TermCell* cell = &back[y * frame_width + x];
+    cell->ch = ch;
+    cell->color = (unsigned char)color;
+}
+
+void term_print(int x, int y, TermColor color, const char* fmt, ...) {
+    char line[512];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+
+    for (int i = 0; line[i] != '\0'; i++) {
+        term_put(x + i, y, line[i], color);
+    }
+}
+
+void term_invalidate() {
+    full_redraw = 1;
+}
+
+int term_present() {
+    if (back == NULL) return -1;
+
+    uint64_t start = now_ns();
+    int cursor_x = -1, cursor_y = -1;
+    int color = -1;
+    uint64_t changed = 0;
+
+    out_len = 0;
+    if (full_redraw) {
+        out_str("\033[H\033[2J");
+    }
+
+    for (int y = 0; y < frame_height; y++) {
+        TermCell* b = &back[y * frame_width];
+        TermCell* f = &front[y * frame_width];
+
+        for (int x = 0; x < frame_width; x++) {
+            if (!full_redraw && b[x].ch == f[x].ch && b[x].color == f[x].color) continue;
+            f[x] = b[x];
+
+            // A blank cleared by the full-screen erase needs no output
+            if (full_redraw && b[x].ch == ' ' && b[x].color == TERM_DEFAULT) continue;
+
+            if (cursor_x != x || cursor_y != y) {
+                out_goto(x, y);
+                cursor_y = y;
+            }
+            if (color != b[x].color) {
+                color = b[x].color;
+                out_str(term_color_codes[color]);
+            }
+
+            out_reserve(1);
+            out_buf[out_len++] = b[x].ch;
+            cursor_x = x + 1;
+            changed++;
+        }
+    }
+
+    if (color > TERM_DEFAULT) {
+        out_str(term_color_codes[TERM_DEFAULT]);
+    }
+    if (out_len > 0) {
+        out_goto(0, frame_height);
+    }
+    full_redraw = 0;
+
+    // Anything printf'd earlier must hit the terminal before the frame does
+    fflush(stdout);
+    int rc = out_len > 0 ? write_all(STDOUT_FILENO, out_buf, out_len) : 0;
+
+    uint64_t end = now_ns();
+    stats.frames++;
+    stats.cells_written += changed;
+    stats.bytes_written += out_len;
+    stats.last_present_ns = end - start;
+    stats.total_present_ns += end - start;
+
+    if (last_frame_ns != 0 && end > last_frame_ns) {
+        double instant = 1e9 / (double)(end - last_frame_ns);
+        stats.fps = stats.fps == 0.0 ? instant : stats.fps * 0.9 + instant * 0.1;
+    }
+    last_frame_ns = end;
+
+    return rc;
+}
+
+void term_get_stats(TermStats* out) {
+    *out = stats;
+}
+
+void term_clear_screen() {
+    static const char seq[] = "\033[H\033[2J\033[3J";
+
+    fflush(stdout);
+    write_all(STDOUT_FILENO, seq, sizeof(seq) - 1);
+    term_invalidate();
+}
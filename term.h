@@ -0,0 +1,52 @@
+#ifndef TERM_H
+#define TERM_H
+
+#include <stdint.h>
+
+// Colors understood by the frame renderer (same palette as the COLOR_* codes in cube.c)
+typedef enum {
+    TERM_DEFAULT = 0,
+    TERM_AQUA,
+    TERM_YELLOW,
+    TERM_PURPLE,
+    TERM_GREEN,
+    TERM_RED,
+    TERM_COLOR_COUNT
+} TermColor;
+
+// A single character cell of a frame buffer
+typedef struct {
+    char ch;               // Character shown in the cell
+    unsigned char color;   // TermColor of the cell
+} TermCell;
+
+// Counters describing how expensive redraws are
+typedef struct {
+    uint64_t frames;            // Frames presented since term_init
+    uint64_t cells_written;     // Cells that actually changed on screen
+    uint64_t bytes_written;     // Bytes handed to write()
+    uint64_t last_present_ns;   // Cost of the most recent term_present
+    uint64_t total_present_ns;  // Accumulated cost of all presents
+    double fps;                 // Smoothed frames per second
+} TermStats;
+
+// Allocate front/back buffers for a width x height frame (0 picks the terminal size)
+int term_init(int width, int height);
+void term_shutdown();
+int term_width();
+int term_height();
+
+// Drawing into the back buffer; nothing reaches the terminal until term_present
+void term_clear();
+void term_put(int x, int y, char ch, TermColor color);
+void term_print(int x, int y, TermColor color, const char* fmt, ...);
+
+// Diff back against front and emit only changed cells with a single write()
+int term_present();
+void term_invalidate();
+void term_get_stats(TermStats* stats);
+
+// In-process replacement for system("clear")
+void term_clear_screen();
+
+#endif